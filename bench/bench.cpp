@@ -0,0 +1,380 @@
+// plugify-launcher-bench: microbenchmarks for the engine independent launcher helpers.
+//
+//   plugify-launcher-bench [--filter <substr>] [--min-time <ms>] [--json] [--out <file>]
+//
+// Every case runs until it has accumulated --min-time of wall time and reports the mean
+// time per operation. The JSON form is meant to be archived per commit for trend tracking.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/console.hpp"
+#include "core/extensions.hpp"
+#include "core/log_writer.hpp"
+
+using namespace plugify;
+namespace fs = std::filesystem;
+
+namespace {
+	// Keeps the optimizer from dropping a computed value
+	template <typename T>
+	void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+		static volatile const void* sink;
+		sink = &value;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	struct BenchResult {
+		std::string name;
+		uint64_t iterations{};
+		double ns_per_op{};
+		double items_per_second{};
+	};
+
+	struct BenchOptions {
+		std::string filter;
+		std::chrono::milliseconds minTime{ 200 };
+		bool json = false;
+		fs::path out;
+	};
+
+	class BenchRunner {
+	public:
+		explicit BenchRunner(BenchOptions options) : _options(std::move(options)) {
+		}
+
+		// Runs op() repeatedly; items is the number of elements one call processes
+		void Run(std::string name, size_t items, const std::function<void()>& op) {
+			if (!_options.filter.empty() && name.find(_options.filter) == std::string::npos) {
+				return;
+			}
+
+			using clock = std::chrono::steady_clock;
+
+			op();  // warm-up
+
+			uint64_t iterations = 0;
+			uint64_t batch = 1;
+			clock::duration elapsed{};
+			while (elapsed < _options.minTime) {
+				auto start = clock::now();
+				for (uint64_t i = 0; i < batch; ++i) {
+					op();
+				}
+				elapsed += clock::now() - start;
+				iterations += batch;
+				batch = std::min<uint64_t>(batch * 2, 1 << 20);
+			}
+
+			auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+			BenchResult result{
+				.name = std::move(name),
+				.iterations = iterations,
+				.ns_per_op = ns / static_cast<double>(iterations),
+				.items_per_second = static_cast<double>(items) * static_cast<double>(iterations) * 1e9 / ns,
+			};
+			if (!_options.json) {
+				std::println(
+				    "{:<48} {:>12} {:>14.1f} ns/op {:>14.0f} items/s",
+				    result.name,
+				    result.iterations,
+				    result.ns_per_op,
+				    result.items_per_second
+				);
+			}
+			_results.push_back(std::move(result));
+		}
+
+		int Finish() const {
+			if (!_options.json) {
+				return 0;
+			}
+
+			glz::json_t::array_t results;
+			results.reserve(_results.size());
+			for (const auto& result : _results) {
+				glz::json_t entry;
+				entry["name"] = result.name;
+				entry["iterations"] = static_cast<double>(result.iterations);
+				entry["ns_per_op"] = result.ns_per_op;
+				entry["items_per_second"] = result.items_per_second;
+				results.emplace_back(std::move(entry));
+			}
+
+			glz::json_t report;
+			report["version"] = S2_PROJECT_VERSION;
+			report["min_time_ms"] = static_cast<double>(_options.minTime.count());
+			report["results"] = glz::json_t::array_t{ std::move(results) };
+
+			auto text = report.dump();
+			if (!text) {
+				std::println(stderr, "Failed to serialize results");
+				return 1;
+			}
+
+			if (_options.out.empty()) {
+				std::println("{}", *text);
+				return 0;
+			}
+
+			std::ofstream file(_options.out, std::ios::binary);
+			if (!file) {
+				std::println(stderr, "Failed to open {}", _options.out.string());
+				return 1;
+			}
+			file << *text;
+			return 0;
+		}
+
+	private:
+		BenchOptions _options;
+		std::vector<BenchResult> _results;
+	};
+
+	// Minimal extension stand-in exposing the getters the listing helpers use
+	struct FakeConstraints {
+		std::string text;
+		const std::string& to_string() const { return text; }
+	};
+
+	struct FakeDependency {
+		std::string name;
+		FakeConstraints constraints;
+		bool optional{};
+
+		const std::string& GetName() const { return name; }
+		const FakeConstraints& GetConstraints() const { return constraints; }
+		bool IsOptional() const { return optional; }
+	};
+
+	struct FakeExtension {
+		UniqueId::Value id{};
+		std::string name;
+		std::string version;
+		uint32_t packedVersion{};
+		bool plugin{};
+		ExtensionState state{};
+		std::string language;
+		fs::path location;
+		std::string description;
+		std::string author;
+		std::vector<FakeDependency> dependencies;
+		std::vector<std::string> errors;
+		std::vector<std::string> warnings;
+		std::chrono::nanoseconds loadTime{};
+
+		UniqueId::Value GetId() const { return id; }
+		const std::string& GetName() const { return name; }
+		const std::string& GetVersionString() const { return version; }
+		uint32_t GetVersion() const { return packedVersion; }
+		bool IsPlugin() const { return plugin; }
+		ExtensionState GetState() const { return state; }
+		const std::string& GetLanguage() const { return language; }
+		const fs::path& GetLocation() const { return location; }
+		const std::string& GetDescription() const { return description; }
+		const std::string& GetAuthor() const { return author; }
+		const std::string& GetWebsite() const { return author; }
+		const std::string& GetLicense() const { return language; }
+		const std::vector<FakeDependency>& GetDependencies() const { return dependencies; }
+		bool HasErrors() const { return !errors.empty(); }
+		bool HasWarnings() const { return !warnings.empty(); }
+		const std::vector<std::string>& GetErrors() const { return errors; }
+		const std::vector<std::string>& GetWarnings() const { return warnings; }
+		std::chrono::nanoseconds GetTotalTime() const { return loadTime; }
+		std::chrono::nanoseconds GetOperationTime(ExtensionState) const { return loadTime; }
+	};
+
+	std::vector<FakeExtension> MakeExtensions(size_t count) {
+		static constexpr std::string_view kLanguages[] = { "cpp", "dotnet", "python", "golang", "lua" };
+		static constexpr ExtensionState kStates[] = {
+			ExtensionState::Started, ExtensionState::Started, ExtensionState::Started,
+			ExtensionState::Loaded,  ExtensionState::Failed,  ExtensionState::Disabled,
+		};
+
+		std::mt19937 rng(static_cast<uint32_t>(count));
+		std::vector<FakeExtension> extensions(count);
+		for (size_t i = 0; i < count; ++i) {
+			auto& ext = extensions[i];
+			auto seed = rng();
+			ext.id = static_cast<UniqueId::Value>(i);
+			ext.name = std::format("plugin_{:08x}", seed);
+			ext.packedVersion = seed % 4096;
+			ext.version = std::format("{}.{}.{}", ext.packedVersion >> 8, (ext.packedVersion >> 4) & 15, ext.packedVersion & 15);
+			ext.plugin = (seed & 1) != 0;
+			ext.state = kStates[seed % std::size(kStates)];
+			ext.language = kLanguages[(seed >> 3) % std::size(kLanguages)];
+			ext.location = fs::path("addons/plugify/extensions") / ext.name;
+			ext.description = std::format("Synthetic extension number {} for benchmarks", i);
+			ext.author = "bench";
+			ext.loadTime = std::chrono::microseconds(seed % 100000);
+			for (size_t d = 0; d < (seed >> 8) % 4; ++d) {
+				ext.dependencies.push_back({ std::format("dep_{}", d), { ">=1.0.0" }, d % 2 == 0 });
+			}
+			if (ext.state == ExtensionState::Failed) {
+				ext.errors.emplace_back("Failed to resolve symbol");
+			}
+		}
+		return extensions;
+	}
+
+	std::string MakeColoredText(size_t lines) {
+		static constexpr char kColors[] = { Colors::RED, Colors::GREEN, Colors::YELLOW, Colors::CYAN, Colors::RESET };
+		std::string text;
+		for (size_t i = 0; i < lines; ++i) {
+			std::format_to(
+			    std::back_inserter(text),
+			    "{}{:<24}{} {:>8} {}state{} {}\n",
+			    kColors[i % std::size(kColors)],
+			    std::format("extension_{}", i),
+			    Colors::RESET,
+			    i * 37,
+			    Colors::GRAY,
+			    Colors::RESET,
+			    "--------------------------------"
+			);
+		}
+		return text;
+	}
+
+	void RunConsole(BenchRunner& runner) {
+		for (size_t lines : { 1, 64, 1024 }) {
+			auto text = MakeColoredText(lines);
+			runner.Run(std::format("AnsiColorParser::Tokenize/{}", lines), text.size(), [&] {
+				auto copy = text;  // Tokenize writes null terminators into its input
+				DoNotOptimize(AnsiColorParser::Tokenize(copy));
+			});
+			runner.Run(std::format("AnsiColorParser::StripColors/{}", lines), text.size(), [&] {
+				DoNotOptimize(AnsiColorParser::StripColors(text));
+			});
+			auto plain = AnsiColorParser::StripColors(text);
+			runner.Run(std::format("SplitConsoleChunks/{}", lines), plain.size(), [&] {
+				auto copy = plain;
+				DoNotOptimize(SplitConsoleChunks(copy));
+			});
+		}
+
+		auto loc = std::source_location::current();
+		for (size_t size : { 32, 512, 4096 }) {
+			std::string message(size, 'x');
+			runner.Run(std::format("FormatLogMessage/{}", size), 1, [&] {
+				DoNotOptimize(FormatLogMessage(message, Severity::Info, loc));
+			});
+		}
+	}
+
+	void RunLogWriter(BenchRunner& runner) {
+		auto dir = fs::temp_directory_path() / "plugify-launcher-bench";
+		std::string message = std::format("{}\n", std::string(120, 'm'));
+
+		for (bool async : { false, true }) {
+			auto path = dir / (async ? "async.log" : "sync.log");
+			{
+				auto writer = LogFileWriter::Create(path, async);
+				if (!writer) {
+					std::println(stderr, "{}", writer.error());
+					return;
+				}
+				runner.Run(std::format("LogFileWriter::Append/{}", async ? "async" : "sync"), 1, [&] {
+					(*writer)->Append(message);
+				});
+			}  // drains the queue before the file is removed
+			std::error_code ec;
+			fs::remove(path, ec);
+		}
+	}
+
+	void RunExtensions(BenchRunner& runner) {
+		FilterOptions byState;
+		byState.states = std::pmr::vector<ExtensionState>{ ExtensionState::Started, ExtensionState::Loaded };
+
+		FilterOptions byLanguage;
+		byLanguage.languages = std::pmr::vector<std::pmr::string>{ "cpp", "python" };
+
+		FilterOptions bySearch;
+		bySearch.searchQuery = "Number 42";
+
+		for (size_t count : { 10, 100, 1000, 10000, 100000 }) {
+			auto storage = MakeExtensions(count);
+			std::vector<const FakeExtension*> extensions;
+			extensions.reserve(storage.size());
+			for (const auto& ext : storage) {
+				extensions.push_back(&ext);
+			}
+
+			runner.Run(std::format("MatchesFilter/search/{}", count), count, [&] {
+				size_t matched = 0;
+				for (const auto* ext : extensions) {
+					matched += MatchesFilter(ext, bySearch);
+				}
+				DoNotOptimize(matched);
+			});
+			runner.Run(std::format("FilterExtensions/state/{}", count), count, [&] {
+				DoNotOptimize(FilterExtensions(extensions, byState));
+			});
+			runner.Run(std::format("FilterExtensions/language/{}", count), count, [&] {
+				DoNotOptimize(FilterExtensions(extensions, byLanguage));
+			});
+			for (auto [label, sortBy] : { std::pair{ "name", SortBy::Name }, std::pair{ "version", SortBy::Version }, std::pair{ "loadtime", SortBy::LoadTime } }) {
+				runner.Run(std::format("SortExtensions/{}/{}", label, count), count, [&] {
+					auto copy = extensions;
+					SortExtensions(copy, sortBy);
+					DoNotOptimize(copy);
+				});
+			}
+			if (count <= 10000) {
+				runner.Run(std::format("ExtensionToJson/{}", count), count, [&] {
+					glz::json_t::array_t objects;
+					objects.reserve(extensions.size());
+					for (const auto* ext : extensions) {
+						objects.emplace_back(ExtensionToJson(ext));
+					}
+					DoNotOptimize(glz::json_t{ std::move(objects) }.dump());
+				});
+			}
+		}
+	}
+
+	void PrintUsage() {
+		std::println("Usage: plugify-launcher-bench [--filter <substr>] [--min-time <ms>] [--json] [--out <file>]");
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchOptions options;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		auto next = [&]() -> std::string_view {
+			return i + 1 < argc ? argv[++i] : std::string_view{};
+		};
+		if (arg == "--filter") {
+			options.filter = next();
+		} else if (arg == "--min-time") {
+			options.minTime = std::chrono::milliseconds(std::atoi(std::string(next()).c_str()));
+		} else if (arg == "--json") {
+			options.json = true;
+		} else if (arg == "--out") {
+			options.out = next();
+		} else {
+			PrintUsage();
+			return arg == "--help" || arg == "-h" ? 0 : 1;
+		}
+	}
+
+	BenchRunner runner(options);
+	RunConsole(runner);
+	RunLogWriter(runner);
+	RunExtensions(runner);
+	return runner.Finish();
+}
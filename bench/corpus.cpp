@@ -0,0 +1,432 @@
+// plugify-launcher-corpus: synthetic extension corpus generator and load-time benchmark.
+//
+//   plugify-launcher-corpus generate <dir> [-n plugins] [-m modules] [--shape <shape>] ...
+//   plugify-launcher-corpus bench [dir] [--loads 1,2,4,8] [--runs 5] [--json] ...
+//
+// <dir> plays the role of addons/plugify: manifests are written below <dir>/envs/bench and the
+// stub library next to each manifest is a hard link to one binary. 'bench' rewrites
+// <dir>/plugify.pconfig for every maxConcurrentLoads value and times CreatePlugifyContext and
+// manager.Initialize() end to end. Without a directory it generates a corpus into a temporary
+// directory first and removes it afterwards.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+#include <glaze/glaze.hpp>
+
+#include <plugify/extension.hpp>
+#include <plugify/logger.hpp>
+#include <plugify/manager.hpp>
+#include <plugify/plugify.hpp>
+
+#include <plg/format.hpp>
+
+#include "core/context.hpp"
+
+using namespace plugify;
+namespace fs = std::filesystem;
+
+namespace {
+	enum class Shape { None, Chain, Diamond, Fanout, Random };
+
+	struct CorpusOptions {
+		size_t plugins = 100;
+		size_t modules = 1;
+		Shape shape = Shape::Chain;
+		size_t width = 0;    // fan-out: children per node, 0 hangs everything off one root
+		size_t degree = 3;   // random: maximum dependencies per plugin
+		uint32_t seed = 1;
+	};
+
+	struct BenchOptions {
+		std::vector<int> loads{ 1, 2, 4, 8 };
+		size_t runs = 5;
+		bool json = false;
+	};
+
+	// Counts problems instead of printing them, a broken corpus would otherwise flood the output
+	class QuietLogger final : public ILogger {
+	public:
+		void Log(std::string_view, Severity severity, std::source_location) override {
+			if (severity <= Severity::Error) {
+				++errors;
+			}
+		}
+
+		void SetLogLevel(Severity) override {
+		}
+
+		void Flush() override {
+		}
+
+		size_t errors{};
+	};
+
+	std::string LibraryName(std::string_view name) {
+		return std::format("{}{}{}", S2_LIBRARY_PREFIX, name, S2_LIBRARY_SUFFIX);
+	}
+
+	// Dependencies of plugin i for the requested graph shape, always on lower indices
+	std::vector<size_t> PluginDependencies(size_t i, const CorpusOptions& options, std::mt19937& rng) {
+		std::vector<size_t> deps;
+		if (i == 0) {
+			return deps;
+		}
+		switch (options.shape) {
+			case Shape::None:
+				break;
+			case Shape::Chain:
+				deps.push_back(i - 1);
+				break;
+			case Shape::Diamond: {
+				// top -> left, right -> bottom, and each top hangs off the previous bottom
+				size_t base = i / 4 * 4;
+				switch (i % 4) {
+					case 0:
+						deps.push_back(i - 1);
+						break;
+					case 1:
+					case 2:
+						deps.push_back(base);
+						break;
+					case 3:
+						deps.push_back(base + 1);
+						deps.push_back(base + 2);
+						break;
+				}
+				break;
+			}
+			case Shape::Fanout:
+				deps.push_back(options.width ? (i - 1) / options.width : 0);
+				break;
+			case Shape::Random: {
+				std::uniform_int_distribution<size_t> count(0, options.degree);
+				std::uniform_int_distribution<size_t> target(0, i - 1);
+				for (size_t n = count(rng); n > 0; --n) {
+					auto dep = target(rng);
+					if (std::find(deps.begin(), deps.end(), dep) == deps.end()) {
+						deps.push_back(dep);
+					}
+				}
+				break;
+			}
+		}
+		return deps;
+	}
+
+	Result<void> WriteFile(const fs::path& path, std::string_view text) {
+		std::error_code ec;
+		fs::create_directories(path.parent_path(), ec);
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			return MakeError("Failed to write {}", plg::as_string(path));
+		}
+		file.write(text.data(), static_cast<std::streamsize>(text.size()));
+		return {};
+	}
+
+	Result<void> LinkStub(const fs::path& stub, const fs::path& target) {
+		std::error_code ec;
+		fs::create_directories(target.parent_path(), ec);
+		fs::create_hard_link(stub, target, ec);
+		if (ec) {
+			fs::copy_file(stub, target, fs::copy_options::overwrite_existing, ec);
+		}
+		if (ec) {
+			return MakeError("Failed to place stub library {}: {}", plg::as_string(target), ec.message());
+		}
+		return {};
+	}
+
+	// Dropped into every generated corpus. A directory without it may be a real install, whose
+	// plugify.pconfig and envs/bench must never be overwritten.
+	constexpr std::string_view kCorpusMarker = ".plugify-corpus";
+
+	Result<void> CheckCorpusDir(const fs::path& baseDir, bool allowEmpty) {
+		std::error_code ec;
+		if (fs::exists(baseDir / kCorpusMarker, ec)) {
+			return {};
+		}
+		if (allowEmpty && (!fs::exists(baseDir, ec) || fs::is_empty(baseDir, ec))) {
+			return {};
+		}
+		return MakeError(
+		    "{} was not generated by this tool (no {}), refusing to overwrite its plugify.pconfig and envs",
+		    plg::as_string(baseDir),
+		    kCorpusMarker
+		);
+	}
+
+	Result<void> WriteConfig(const fs::path& baseDir, int maxConcurrentLoads) {
+		glz::json_t config;
+		config["paths"]["baseDir"] = "addons/plugify";
+		config["loading"]["preferOwnSymbols"] = false;
+		config["loading"]["maxConcurrentLoads"] = static_cast<double>(maxConcurrentLoads);
+		config["logging"]["severity"] = "error";
+		auto text = config.dump();
+		if (!text) {
+			return MakeError("Failed to serialize plugify.pconfig");
+		}
+		return WriteFile(baseDir / "plugify.pconfig", *text);
+	}
+
+	Result<size_t> Generate(const fs::path& baseDir, const CorpusOptions& options) {
+		fs::path stub = fs::path(S2_BENCH_STUB_PATH);
+		std::error_code ec;
+		if (!fs::exists(stub, ec)) {
+			return MakeError("Stub library not found: {}", plg::as_string(stub));
+		}
+
+		if (auto result = CheckCorpusDir(baseDir, true); !result) {
+			return MakeError(std::move(result.error()));
+		}
+		if (auto result = WriteFile(baseDir / kCorpusMarker, "Generated by plugify-launcher-corpus\n"); !result) {
+			return MakeError(std::move(result.error()));
+		}
+
+		auto root = BuildPaths(baseDir).extensionsDir;
+		auto envDir = baseDir / root / "bench";
+		fs::remove_all(envDir, ec);
+
+		auto modules = std::max<size_t>(options.modules, 1);
+		for (size_t j = 0; j < modules; ++j) {
+			auto name = std::format("bench_module_{}", j);
+			auto dir = envDir / "modules" / name;
+			glz::json_t manifest;
+			manifest["name"] = name;
+			manifest["version"] = "1.0.0";
+			manifest["language"] = std::format("bench{}", j);
+			manifest["runtime"] = std::format("bin/{}", LibraryName(name));
+			if (auto result = WriteFile(dir / (name + ".pmodule"), *manifest.dump()); !result) {
+				return MakeError(std::move(result.error()));
+			}
+			if (auto result = LinkStub(stub, dir / "bin" / LibraryName(name)); !result) {
+				return MakeError(std::move(result.error()));
+			}
+		}
+
+		std::mt19937 rng(options.seed);
+		for (size_t i = 0; i < options.plugins; ++i) {
+			auto name = std::format("bench_plugin_{}", i);
+			auto dir = envDir / "plugins" / name;
+
+			glz::json_t::array_t dependencies;
+			for (auto dep : PluginDependencies(i, options, rng)) {
+				glz::json_t::object_t depJson;
+				depJson["name"] = std::format("bench_plugin_{}", dep);
+				depJson["constraints"] = ">=1.0.0";
+				dependencies.emplace_back(std::move(depJson));
+			}
+
+			glz::json_t manifest;
+			manifest["name"] = name;
+			manifest["version"] = "1.0.0";
+			manifest["description"] = std::format("Synthetic plugin {} of {}", i + 1, options.plugins);
+			manifest["language"] = std::format("bench{}", i % modules);
+			manifest["entry"] = std::format("bin/{}", LibraryName(name));
+			manifest["dependencies"] = glz::json_t::array_t{ std::move(dependencies) };
+			manifest["methods"] = glz::json_t::array_t{};
+			if (auto result = WriteFile(dir / (name + ".pplugin"), *manifest.dump()); !result) {
+				return MakeError(std::move(result.error()));
+			}
+			if (auto result = LinkStub(stub, dir / "bin" / LibraryName(name)); !result) {
+				return MakeError(std::move(result.error()));
+			}
+		}
+
+		return modules + options.plugins;
+	}
+
+	struct RunResult {
+		int loads{};
+		std::vector<double> context;  // ms
+		std::vector<double> manager;  // ms
+		size_t extensions{};
+		size_t failed{};
+		size_t errors{};
+	};
+
+	double Median(std::vector<double> values) {
+		if (values.empty()) {
+			return 0.0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[values.size() / 2];
+	}
+
+	double Min(const std::vector<double>& values) {
+		return values.empty() ? 0.0 : *std::min_element(values.begin(), values.end());
+	}
+
+	Result<RunResult> Measure(const fs::path& baseDir, int loads, size_t runs) {
+		using namespace std::chrono;
+
+		if (auto result = WriteConfig(baseDir, loads); !result) {
+			return MakeError(std::move(result.error()));
+		}
+
+		RunResult run{ .loads = loads };
+		for (size_t i = 0; i < runs; ++i) {
+			auto logger = std::make_shared<QuietLogger>();
+
+			auto start = steady_clock::now();
+			auto context = CreatePlugifyContext(baseDir, logger);
+			if (!context) {
+				return MakeError(std::move(context.error()));
+			}
+			auto created = steady_clock::now();
+
+			auto& manager = (*context)->GetManager();
+			if (auto result = manager.Initialize(); !result) {
+				return MakeError("Failed to initialize plugin manager: {}", result.error());
+			}
+			auto initialized = steady_clock::now();
+
+			run.context.push_back(duration<double, std::milli>(created - start).count());
+			run.manager.push_back(duration<double, std::milli>(initialized - created).count());
+
+			const auto& extensions = manager.GetExtensions();
+			run.extensions = extensions.size();
+			run.failed = static_cast<size_t>(std::count_if(extensions.begin(), extensions.end(), [](const auto& ext) {
+				return ext->GetState() == ExtensionState::Failed || ext->GetState() == ExtensionState::Unresolved;
+			}));
+			run.errors = logger->errors;
+
+			manager.Terminate();
+		}
+		return run;
+	}
+
+	int Bench(const fs::path& baseDir, const BenchOptions& options) {
+		std::vector<RunResult> results;
+		for (int loads : options.loads) {
+			auto run = Measure(baseDir, loads, std::max<size_t>(options.runs, 1));
+			if (!run) {
+				std::println(stderr, "Error: {}", run.error());
+				return 1;
+			}
+			results.push_back(std::move(*run));
+		}
+
+		if (options.json) {
+			glz::json_t::array_t rows;
+			for (const auto& run : results) {
+				glz::json_t row;
+				row["max_concurrent_loads"] = static_cast<double>(run.loads);
+				row["extensions"] = static_cast<double>(run.extensions);
+				row["failed"] = static_cast<double>(run.failed);
+				row["errors"] = static_cast<double>(run.errors);
+				row["context_ms"]["min"] = Min(run.context);
+				row["context_ms"]["median"] = Median(run.context);
+				row["manager_ms"]["min"] = Min(run.manager);
+				row["manager_ms"]["median"] = Median(run.manager);
+				rows.emplace_back(std::move(row));
+			}
+			glz::json_t report;
+			report["corpus"] = plg::as_string(baseDir);
+			report["runs"] = static_cast<double>(options.runs);
+			report["results"] = glz::json_t::array_t{ std::move(rows) };
+			std::println("{}", *report.dump());
+			return 0;
+		}
+
+		std::println("{:>6} {:>10} {:>8} {:>14} {:>14} {:>14} {:>14}", "loads", "extensions", "failed", "context min", "context med", "manager min", "manager med");
+		for (const auto& run : results) {
+			std::println(
+			    "{:>6} {:>10} {:>8} {:>11.2f} ms {:>11.2f} ms {:>11.2f} ms {:>11.2f} ms",
+			    run.loads,
+			    run.extensions,
+			    run.failed,
+			    Min(run.context),
+			    Median(run.context),
+			    Min(run.manager),
+			    Median(run.manager)
+			);
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	CLI::App app{ "Synthetic extension corpus generator and load-time benchmark" };
+	app.require_subcommand(1);
+
+	CorpusOptions corpus;
+	BenchOptions bench;
+	std::string directory;
+	bool keep = false;
+
+	std::map<std::string, Shape> shapes{
+		{ "none", Shape::None },
+		{ "chain", Shape::Chain },
+		{ "diamond", Shape::Diamond },
+		{ "fanout", Shape::Fanout },
+		{ "random", Shape::Random },
+	};
+
+	auto addCorpusOptions = [&](CLI::App* cmd) {
+		cmd->add_option("-n,--plugins", corpus.plugins, "Number of plugins")->capture_default_str();
+		cmd->add_option("-m,--modules", corpus.modules, "Number of language modules")->capture_default_str();
+		cmd->add_option("--shape", corpus.shape, "Dependency graph: none, chain, diamond, fanout, random")
+		    ->transform(CLI::CheckedTransformer(shapes, CLI::ignore_case));
+		cmd->add_option("--width", corpus.width, "Fan-out children per node (0 = single root)");
+		cmd->add_option("--degree", corpus.degree, "Maximum dependencies per plugin for random graphs");
+		cmd->add_option("--seed", corpus.seed, "Random seed");
+	};
+
+	auto* generate = app.add_subcommand("generate", "Write a synthetic corpus");
+	generate->add_option("dir", directory, "Empty or previously generated corpus directory (acts as addons/plugify)")->required();
+	addCorpusOptions(generate);
+
+	auto* run = app.add_subcommand("bench", "Time context creation and manager initialization");
+	run->add_option("dir", directory, "Corpus directory written by 'generate', generated into a temporary one when omitted");
+	run->add_option("--loads", bench.loads, "maxConcurrentLoads values to try")->delimiter(',');
+	run->add_option("--runs", bench.runs, "Runs per setting")->capture_default_str();
+	run->add_flag("--json", bench.json, "Print results as JSON");
+	run->add_flag("--keep", keep, "Keep the temporary corpus");
+	addCorpusOptions(run);
+
+	CLI11_PARSE(app, argc, argv);
+
+	if (generate->parsed()) {
+		auto count = Generate(directory, corpus);
+		if (!count) {
+			std::println(stderr, "Error: {}", count.error());
+			return 1;
+		}
+		std::println("Generated {} extensions in {}", *count, directory);
+		return 0;
+	}
+
+	fs::path baseDir = directory;
+	bool temporary = baseDir.empty();
+	if (temporary) {
+		baseDir = fs::temp_directory_path() / std::format("plugify-corpus-{}", std::random_device{}());
+		if (auto count = Generate(baseDir, corpus); !count) {
+			std::println(stderr, "Error: {}", count.error());
+			return 1;
+		}
+	}
+
+	if (auto result = CheckCorpusDir(baseDir, false); !result) {
+		std::println(stderr, "Error: {}", result.error());
+		return 1;
+	}
+
+	int status = Bench(baseDir, bench);
+
+	if (temporary && !keep) {
+		std::error_code ec;
+		fs::remove_all(baseDir, ec);
+	}
+	return status;
+}
@@ -0,0 +1,208 @@
+// Stand-in for libengine2: drives the launcher through the same entry points as the real engine.
+//
+// Source2Main registers a few app system modules on a CMaterialSystem2AppSystemDict (the launcher
+// hooks its OnAppSystemLoaded and initializes Plugify on S2_GAME_START), loads the fake server and
+// then runs a synthetic tick loop through CLightQueryGameSystem::ServerGamePostSimulate.
+//
+// Command line:
+//   -ticks <n>        ticks to run before returning (default 1000)
+//   -tickrate <hz>    tick frequency, 0 runs unthrottled (default 64)
+//   -tickwork <us>    CPU time the server burns per tick (default 0)
+//   -report <file>    write a JSON summary instead of printing it
+//   -quiet            do not echo engine log messages to stdout
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include <appframework/iappsystem.h>
+#include <igamesystem.h>
+
+#define FAKE_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace fs = std::filesystem;
+
+extern "C" void FakeTier0_SetQuiet(bool quiet);
+
+class CMaterialSystem2AppSystemDict : public CAppSystemDict {
+public:
+	void OnAppSystemLoaded() override {
+	}
+};
+
+namespace {
+	struct Options {
+		uint64_t ticks = 1000;
+		double tickrate = 64.0;
+		int64_t tickwork = 0;  // us
+		std::string report;
+		bool quiet = false;
+	};
+
+	Options ParseCommandLine(std::string_view cmdLine) {
+		std::vector<std::string_view> args;
+		for (size_t pos = 0; pos < cmdLine.size();) {
+			auto end = cmdLine.find(' ', pos);
+			if (end == std::string_view::npos) {
+				end = cmdLine.size();
+			}
+			if (end > pos) {
+				args.push_back(cmdLine.substr(pos, end - pos));
+			}
+			pos = end + 1;
+		}
+
+		Options options;
+		for (size_t i = 0; i < args.size(); ++i) {
+			auto value = [&]() -> std::string {
+				return i + 1 < args.size() ? std::string(args[++i]) : std::string{};
+			};
+			if (args[i] == "-ticks") {
+				options.ticks = std::stoull(value());
+			} else if (args[i] == "-tickrate") {
+				options.tickrate = std::stod(value());
+			} else if (args[i] == "-tickwork") {
+				options.tickwork = std::stoll(value());
+			} else if (args[i] == "-report") {
+				options.report = value();
+			} else if (args[i] == "-quiet") {
+				options.quiet = true;
+			}
+		}
+		return options;
+	}
+
+	// Same order the dedicated server brings its app systems up in, trimmed to what matters
+	constexpr const char* kModules[] = {
+		"filesystem_stdio",
+		"engine2",
+		"server",
+		S2_GAME_START,
+	};
+
+	int64_t Percentile(std::vector<int64_t>& values, double p) {
+		if (values.empty()) {
+			return 0;
+		}
+		auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+		std::nth_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(index), values.end());
+		return values[index];
+	}
+}
+
+FAKE_EXPORT int Source2Main(
+    void*,
+    void*,
+    const char* pszCmdLine,
+    int,
+    const char* pszBaseDir,
+    const char* pszGame
+) {
+	using namespace std::chrono;
+
+	auto entry = steady_clock::now();
+	auto options = ParseCommandLine(pszCmdLine ? pszCmdLine : "");
+	FakeTier0_SetQuiet(options.quiet);
+
+	// The launcher looks the server module up by name once S2_GAME_START is reported
+	auto serverPath = fs::path(pszBaseDir) / "libserver.so";
+	void* server = ::dlopen(serverPath.c_str(), RTLD_NOW | RTLD_GLOBAL);
+	if (!server) {
+		std::fprintf(stderr, "Fake engine: %s\n", ::dlerror());
+		return 1;
+	}
+
+	using GetGameSystemFn = IGameSystem* (*)();
+	using SetTickWorkFn = void (*)(int64_t);
+	using GetLastWorkFn = int64_t (*)();
+	auto GetGameSystem = reinterpret_cast<GetGameSystemFn>(::dlsym(server, "FakeServer_GetGameSystem"));
+	auto SetTickWork = reinterpret_cast<SetTickWorkFn>(::dlsym(server, "FakeServer_SetTickWork"));
+	auto GetLastWork = reinterpret_cast<GetLastWorkFn>(::dlsym(server, "FakeServer_GetLastWork"));
+	if (!GetGameSystem || !SetTickWork || !GetLastWork) {
+		std::fprintf(stderr, "Fake engine: %s is not the stand-in server\n", serverPath.c_str());
+		return 1;
+	}
+	SetTickWork(duration_cast<nanoseconds>(microseconds(options.tickwork)).count());
+
+	// Calls go through the base class so they hit the (possibly hooked) vtable
+	auto* dict = new CMaterialSystem2AppSystemDict();
+	CAppSystemDict* appSystems = dict;
+	for (const char* name : kModules) {
+		auto index = appSystems->m_Modules.AddToTail();
+		appSystems->m_Modules[index].m_pModuleName = name;
+		appSystems->OnAppSystemLoaded();
+	}
+
+	auto loaded = steady_clock::now();
+
+	IGameSystem* system = GetGameSystem();
+	EventServerGamePostSimulate_t msg{};
+
+	std::vector<int64_t> overhead;
+	overhead.reserve(static_cast<size_t>(options.ticks));
+	auto interval = options.tickrate > 0 ? duration_cast<steady_clock::duration>(duration<double>(1.0 / options.tickrate)) : steady_clock::duration{};
+	auto next = steady_clock::now();
+	steady_clock::time_point firstTick;
+
+	for (uint64_t tick = 0; tick < options.ticks; ++tick) {
+		auto start = steady_clock::now();
+		if (tick == 0) {
+			firstTick = start;
+		}
+		system->ServerGamePostSimulate(msg);
+		auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+		overhead.push_back(std::max<int64_t>(0, elapsed - GetLastWork()));
+
+		if (interval.count() > 0) {
+			next += interval;
+			std::this_thread::sleep_until(next);
+		}
+	}
+
+	auto done = steady_clock::now();
+
+	int64_t total = 0;
+	for (auto value : overhead) {
+		total += value;
+	}
+	auto mean = overhead.empty() ? 0 : total / static_cast<int64_t>(overhead.size());
+	auto p50 = Percentile(overhead, 0.50);
+	auto p99 = Percentile(overhead, 0.99);
+	auto max = overhead.empty() ? 0 : *std::max_element(overhead.begin(), overhead.end());
+
+	auto report = std::format(
+	    R"({{"game":"{}","ticks":{},"tickrate":{},"tickwork_us":{},"startup_us":{},"first_tick_us":{},"loop_us":{},"tick_overhead_ns":{{"mean":{},"p50":{},"p99":{},"max":{}}}}})",
+	    pszGame ? pszGame : "",
+	    options.ticks,
+	    options.tickrate,
+	    options.tickwork,
+	    duration_cast<microseconds>(loaded - entry).count(),
+	    duration_cast<microseconds>((options.ticks ? firstTick : loaded) - entry).count(),
+	    duration_cast<microseconds>(done - loaded).count(),
+	    mean,
+	    p50,
+	    p99,
+	    max
+	);
+
+	if (options.report.empty()) {
+		std::fprintf(stdout, "%s\n", report.c_str());
+	} else if (std::ofstream file(options.report, std::ios::binary); file) {
+		file << report << '\n';
+	} else {
+		std::fprintf(stderr, "Fake engine: failed to write %s\n", options.report.c_str());
+	}
+
+	delete dict;
+	return 0;
+}
@@ -0,0 +1,43 @@
+// Stand-in for libserver: owns a CLightQueryGameSystem whose ServerGamePostSimulate burns a
+// configurable amount of CPU, standing in for the game simulation the launcher hooks after.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <igamesystem.h>
+
+#define FAKE_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace {
+	std::atomic<int64_t> s_workNs{ 0 };
+	std::atomic<int64_t> s_lastWorkNs{ 0 };
+}
+
+class CLightQueryGameSystem : public CBaseGameSystem {
+public:
+	void ServerGamePostSimulate(const EventServerGamePostSimulate_t&) override {
+		auto start = std::chrono::steady_clock::now();
+		auto deadline = start + std::chrono::nanoseconds(s_workNs.load(std::memory_order_relaxed));
+		while (std::chrono::steady_clock::now() < deadline) {
+		}
+		s_lastWorkNs.store(
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+		    std::memory_order_relaxed
+		);
+	}
+};
+
+FAKE_EXPORT IGameSystem* FakeServer_GetGameSystem() {
+	static CLightQueryGameSystem system;
+	return &system;
+}
+
+FAKE_EXPORT void FakeServer_SetTickWork(int64_t nanoseconds) {
+	s_workNs.store(nanoseconds, std::memory_order_relaxed);
+}
+
+// Time spent inside the original ServerGamePostSimulate during the last tick
+FAKE_EXPORT int64_t FakeServer_GetLastWork() {
+	return s_lastWorkNs.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,125 @@
+// Stand-in for libtier0: logging system and platform queries used by the launcher.
+// Messages go to stdout (unless quiet) and to every listener of the current logging state.
+
+#include <climits>
+#include <cstdarg>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <tier0/logging.h>
+#include <tier0/platform.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+	struct Channel {
+		std::string name;
+		int flags;
+		LoggingVerbosity_t verbosity;
+		Color color;
+	};
+
+	std::mutex s_mutex;
+	std::vector<Channel> s_channels;
+	std::vector<std::vector<ILoggingListener*>> s_states(1);
+	bool s_quiet = false;
+
+	LoggingResponse_t Dispatch(LoggingChannelID_t channelID, LoggingSeverity_t severity, Color color, const char* format, va_list args) {
+		char buffer[4096];
+		std::vsnprintf(buffer, sizeof(buffer), format, args);
+
+		std::scoped_lock lock(s_mutex);
+		if (channelID < 0 || static_cast<size_t>(channelID) >= s_channels.size()) {
+			return LR_CONTINUE;
+		}
+
+		LoggingContext_t context{};
+		context.m_ChannelID = channelID;
+		context.m_Flags = static_cast<LoggingChannelFlags_t>(s_channels[static_cast<size_t>(channelID)].flags);
+		context.m_Severity = severity;
+		context.m_Color = color;
+
+		if (!s_quiet) {
+			std::fputs(buffer, stdout);
+		}
+		for (auto* listener : s_states.back()) {
+			listener->Log(&context, buffer);
+		}
+		return LR_CONTINUE;
+	}
+
+	std::string ResolveGameDirectory() {
+		// The launcher lives in <game>/bin/<platform>
+		char path[PATH_MAX];
+		auto len = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+		if (len <= 0) {
+			return fs::current_path().string();
+		}
+		path[len] = '\0';
+		auto dir = fs::path(path).parent_path();
+		if (dir.parent_path().filename() == "bin") {
+			return dir.parent_path().parent_path().string();
+		}
+		return dir.string();
+	}
+}
+
+extern "C" __attribute__((visibility("default"))) void FakeTier0_SetQuiet(bool quiet) {
+	std::scoped_lock lock(s_mutex);
+	s_quiet = quiet;
+}
+
+LoggingChannelID_t LoggingSystem_RegisterLoggingChannel(
+    const char* pChannelName,
+    RegisterTagsFunc,
+    int flags,
+    LoggingVerbosity_t verbosity,
+    Color color
+) {
+	std::scoped_lock lock(s_mutex);
+	s_channels.push_back({ pChannelName ? pChannelName : "", flags, verbosity, color });
+	return static_cast<LoggingChannelID_t>(s_channels.size() - 1);
+}
+
+void LoggingSystem_RegisterLoggingListener(ILoggingListener* pListener) {
+	std::scoped_lock lock(s_mutex);
+	s_states.back().push_back(pListener);
+}
+
+void LoggingSystem_PushLoggingState(bool, bool bClearState) {
+	std::scoped_lock lock(s_mutex);
+	s_states.push_back(bClearState ? std::vector<ILoggingListener*>{} : s_states.back());
+}
+
+void LoggingSystem_PopLoggingState(bool) {
+	std::scoped_lock lock(s_mutex);
+	if (s_states.size() > 1) {
+		s_states.pop_back();
+	}
+}
+
+LoggingResponse_t LoggingSystem_Log(LoggingChannelID_t channelID, LoggingSeverity_t severity, const char* pMessageFormat, ...) {
+	va_list args;
+	va_start(args, pMessageFormat);
+	auto response = Dispatch(channelID, severity, UNSPECIFIED_LOGGING_COLOR, pMessageFormat, args);
+	va_end(args);
+	return response;
+}
+
+LoggingResponse_t LoggingSystem_Log(LoggingChannelID_t channelID, LoggingSeverity_t severity, Color color, const char* pMessageFormat, ...) {
+	va_list args;
+	va_start(args, pMessageFormat);
+	auto response = Dispatch(channelID, severity, color, pMessageFormat, args);
+	va_end(args);
+	return response;
+}
+
+const char* Plat_GetGameDirectory() {
+	static const std::string directory = ResolveGameDirectory();
+	return directory.c_str();
+}
@@ -0,0 +1,12 @@
+// Placeholder binary referenced by generated extension manifests. It only needs to be a loadable
+// shared library; the corpus benchmark measures discovery, resolution and load scheduling.
+
+extern "C"
+#if defined(_WIN32)
+__declspec(dllexport)
+#else
+__attribute__((visibility("default")))
+#endif
+int plugify_bench_stub() {
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "arena.hpp"
+
+#include <optional>
+
+struct CommandArena::State {
+	std::unique_ptr<std::byte[]> block = std::make_unique<std::byte[]>(kBlockSize);
+	CountingResource heap{ std::pmr::new_delete_resource() };
+	std::optional<std::pmr::monotonic_buffer_resource> arena;
+	std::optional<CountingResource> counted;
+	size_t depth = 0;
+	Stats last;
+};
+
+CommandArena::State& CommandArena::Local() {
+	thread_local State state;
+	return state;
+}
+
+CommandArena::Scope::Scope() {
+	auto& state = Local();
+	if (state.depth++ == 0) {
+		state.heap.allocations = 0;
+		state.heap.bytes = 0;
+		state.arena.emplace(state.block.get(), kBlockSize, &state.heap);
+		state.counted.emplace(&*state.arena);
+	}
+}
+
+CommandArena::Scope::~Scope() {
+	auto& state = Local();
+	if (--state.depth == 0) {
+		state.last = {
+			.allocations = state.counted->allocations,
+			.bytes = state.counted->bytes,
+			.heapAllocations = state.heap.allocations,
+		};
+		state.counted.reset();
+		state.arena.reset();  // hands any overflow blocks back to the heap
+	}
+}
+
+std::pmr::memory_resource* CommandArena::Get() {
+	auto& state = Local();
+	return state.depth ? &*state.counted : std::pmr::get_default_resource();
+}
+
+CommandArena::Stats CommandArena::Last() {
+	return Local().last;
+}
+
+void* CommandArena::CountingResource::do_allocate(size_t size, size_t alignment) {
+	++allocations;
+	bytes += size;
+	return _upstream->allocate(size, alignment);
+}
+
+void CommandArena::CountingResource::do_deallocate(void* ptr, size_t size, size_t alignment) {
+	_upstream->deallocate(ptr, size, alignment);
+}
+
+bool CommandArena::CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Scratch memory for one console command. The listing helpers allocate their temporaries from
+// CommandArena::Get(); while a Scope is alive on the calling thread that is a monotonic resource
+// over a block reused by every command, released when the outermost Scope ends. Anywhere else
+// Get() is the default heap resource.
+class CommandArena {
+public:
+	static constexpr size_t kBlockSize = 64 * 1024;
+
+	struct Stats {
+		size_t allocations{};      // requests served by the arena
+		size_t bytes{};            // bytes requested from the arena
+		size_t heapAllocations{};  // blocks the arena had to take from the heap
+	};
+
+	class Scope {
+	public:
+		Scope();
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	static std::pmr::memory_resource* Get();
+
+	// Usage of the last command that finished on this thread
+	static Stats Last();
+
+private:
+	// Forwards to another resource and counts what goes through it
+	class CountingResource final : public std::pmr::memory_resource {
+	public:
+		explicit CountingResource(std::pmr::memory_resource* upstream)
+		    : _upstream(upstream) {
+		}
+
+		size_t allocations = 0;
+		size_t bytes = 0;
+
+	private:
+		void* do_allocate(size_t size, size_t alignment) override;
+		void do_deallocate(void* ptr, size_t size, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		std::pmr::memory_resource* _upstream;
+	};
+
+	struct State;
+	static State& Local();
+};
@@ -0,0 +1,194 @@
+#include "command_log.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+#include <glaze/glaze.hpp>
+
+#include <plg/format.hpp>
+
+using namespace plugify;
+namespace fs = std::filesystem;
+
+bool CommandRecorder::Start() {
+	std::scoped_lock lock(_mutex);
+	if (_recording) {
+		return false;
+	}
+	_commands.clear();
+	_origin = std::chrono::steady_clock::now();
+	_recording = true;
+	return true;
+}
+
+bool CommandRecorder::IsRecording() {
+	std::scoped_lock lock(_mutex);
+	return _recording;
+}
+
+void CommandRecorder::Record(std::string_view line, std::chrono::microseconds latency) {
+	std::scoped_lock lock(_mutex);
+	if (!_recording) {
+		return;
+	}
+	auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
+	    std::chrono::steady_clock::now() - _origin
+	) - latency;
+	_commands.push_back({ offset.count(), std::string(line), latency.count() });
+}
+
+Result<size_t> CommandRecorder::Stop(const fs::path& path) {
+	std::vector<RecordedCommand> commands;
+	{
+		std::scoped_lock lock(_mutex);
+		if (!_recording) {
+			return MakeError("Command recording is not running");
+		}
+		_recording = false;
+		commands = std::move(_commands);
+		_commands = {};
+	}
+
+	auto result = Write(path, commands);
+	if (!result) {
+		// Keep recording so the stream survives and 'stop' can be retried with another file
+		std::scoped_lock lock(_mutex);
+		commands.insert(commands.end(), std::make_move_iterator(_commands.begin()), std::make_move_iterator(_commands.end()));
+		_commands = std::move(commands);
+		_recording = true;
+	}
+	return result;
+}
+
+Result<size_t> CommandRecorder::Write(const fs::path& path, const std::vector<RecordedCommand>& commands) {
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+
+	errno = 0;
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		return MakeError(
+		    "Failed to open command log: {} - {}",
+		    plg::as_string(path),
+		    std::strerror(errno)
+		);
+	}
+
+	for (const auto& command : commands) {
+		auto json = glz::write_json(command);
+		if (!json) {
+			return MakeError("Failed to serialize command: {}", command.line);
+		}
+		file << *json << '\n';
+	}
+
+	if (!file.flush()) {
+		return MakeError(
+		    "Failed to write command log: {} - {}",
+		    plg::as_string(path),
+		    std::strerror(errno)
+		);
+	}
+	return commands.size();
+}
+
+Result<std::vector<RecordedCommand>> LoadCommandLog(const fs::path& path) {
+	errno = 0;
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return MakeError(
+		    "Failed to open command log: {} - {}",
+		    plg::as_string(path),
+		    std::strerror(errno)
+		);
+	}
+
+	std::vector<RecordedCommand> commands;
+	std::string line;
+	size_t number = 0;
+	while (std::getline(file, line)) {
+		++number;
+		if (line.empty()) {
+			continue;
+		}
+		auto command = glz::read_json<RecordedCommand>(line);
+		if (!command) {
+			return MakeError("{}:{}: {}", plg::as_string(path), number, glz::format_error(command.error(), line));
+		}
+		commands.push_back(std::move(*command));
+	}
+	return commands;
+}
+
+std::string CommandKey(std::string_view line) {
+	std::vector<std::string_view> tokens;
+	for (size_t pos = 0; pos < line.size();) {
+		auto start = line.find_first_not_of(" \t", pos);
+		if (start == std::string_view::npos) {
+			break;
+		}
+		auto end = line.find_first_of(" \t", start);
+		if (end == std::string_view::npos) {
+			end = line.size();
+		}
+		tokens.push_back(line.substr(start, end - start));
+		pos = end;
+	}
+	if (tokens.empty()) {
+		return {};
+	}
+
+	std::string_view command = tokens[0];
+	if (command == "plg" || command == "plug") {
+		command = "plugify";
+	} else if (command == "conda" || command == "micromamba") {
+		command = "mamba";
+	}
+
+	std::string key(command);
+	for (size_t i = 1; i < tokens.size(); ++i) {
+		if (!tokens[i].starts_with('-')) {
+			key += ' ';
+			key += tokens[i];
+			break;
+		}
+	}
+	return key;
+}
+
+std::vector<LatencySummary> SummarizeLatencies(std::vector<std::pair<std::string, int64_t>> samples) {
+	std::unordered_map<std::string, std::vector<int64_t>> groups;
+	for (auto& [key, latency] : samples) {
+		groups[std::move(key)].push_back(latency);
+	}
+
+	std::vector<LatencySummary> summaries;
+	summaries.reserve(groups.size());
+	for (auto& [key, values] : groups) {
+		std::sort(values.begin(), values.end());
+		auto at = [&values](double p) {
+			return values[static_cast<size_t>(p * static_cast<double>(values.size() - 1))];
+		};
+		LatencySummary summary{
+			.key = key,
+			.count = values.size(),
+			.p50_us = at(0.50),
+			.p90_us = at(0.90),
+			.p99_us = at(0.99),
+			.max_us = values.back(),
+		};
+		for (auto value : values) {
+			summary.total_us += value;
+		}
+		summaries.push_back(std::move(summary));
+	}
+
+	std::sort(summaries.begin(), summaries.end(), [](const auto& a, const auto& b) {
+		return a.total_us > b.total_us;
+	});
+	return summaries;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <plugify/plugify.hpp>
+
+// One console invocation, stored as a JSON line
+struct RecordedCommand {
+	int64_t offset_us{};   // since the recording started
+	std::string line;      // full command string as typed
+	int64_t latency_us{};  // time spent in the handler
+};
+
+// Captures the console command stream ('plugify record start|stop')
+class CommandRecorder {
+public:
+	static bool Start();
+	static bool IsRecording();
+	static void Record(std::string_view line, std::chrono::microseconds latency);
+
+	// Stops and writes the JSON lines file, returns the number of commands. When the file cannot
+	// be written the recording keeps running with everything captured so far.
+	static plugify::Result<size_t> Stop(const std::filesystem::path& path);
+
+private:
+	static plugify::Result<size_t> Write(const std::filesystem::path& path, const std::vector<RecordedCommand>& commands);
+
+	inline static std::mutex _mutex;
+	inline static bool _recording{ false };
+	inline static std::chrono::steady_clock::time_point _origin;
+	inline static std::vector<RecordedCommand> _commands;
+};
+
+plugify::Result<std::vector<RecordedCommand>> LoadCommandLog(const std::filesystem::path& path);
+
+// Normalized "command subcommand" used to group latencies, aliases collapse into one key
+// (plg/plug -> plugify, conda/micromamba -> mamba) and options are skipped.
+std::string CommandKey(std::string_view line);
+
+struct LatencySummary {
+	std::string key;
+	size_t count{};
+	int64_t p50_us{};
+	int64_t p90_us{};
+	int64_t p99_us{};
+	int64_t max_us{};
+	int64_t total_us{};
+};
+
+// Per-key latency distribution sorted by total time, samples are consumed
+std::vector<LatencySummary> SummarizeLatencies(std::vector<std::pair<std::string, int64_t>> samples);
@@ -0,0 +1,93 @@
+#include "console.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+
+#include <plg/enum.hpp>
+
+std::vector<AnsiColorParser::TextSegment> AnsiColorParser::Tokenize(std::string_view str) {
+	std::vector<TextSegment> segments;
+
+	uint8_t current_code = static_cast<uint8_t>(Colors::WHITE);
+	size_t text_start = 0;
+
+	for (size_t i = 0; i < str.length(); ++i) {
+		auto byte = static_cast<unsigned char>(str[i]);
+		if (byte < 32 && isColorCode[byte]) {
+			const_cast<char&>(str[i]) = '\0';  // Null-terminate at color
+
+			// Found color code
+			if (i > text_start) {
+				segments.emplace_back(str.substr(text_start, i - text_start), current_code);
+			}
+
+			current_code = byte;
+			text_start = i + 1;
+		}
+	}
+
+	// Add remaining text
+	if (text_start < str.length()) {
+		segments.emplace_back(str.substr(text_start), current_code);
+	}
+
+	return segments;
+}
+
+std::string AnsiColorParser::StripColors(std::string_view input) {
+	std::string result;
+	result.reserve(input.length());
+
+	for (char c : input) {
+		auto byte = static_cast<unsigned char>(c);
+		if (byte >= 32 || !isColorCode[byte]) {
+			result += c;
+		}
+	}
+
+	return result;
+}
+
+std::vector<std::string_view> SplitConsoleChunks(std::string_view str, size_t max_size) {
+	std::vector<std::string_view> segments;
+
+	for (size_t pos = 0; pos < str.size();) {
+		size_t chunk_size = std::min(max_size, str.size() - pos);
+
+		// Try to break at space if we're at max size and not at the end
+		if (chunk_size == max_size && pos + chunk_size < str.size()) {
+			// Look for space within the chunk
+			auto nl_pos = str.rfind('\n', pos + chunk_size - 1);
+			if (nl_pos != std::string_view::npos && nl_pos > pos) {
+				const_cast<char&>(str[nl_pos]) = '\0';  // Null-terminate at space
+				chunk_size = nl_pos - pos;
+			}
+		}
+
+		segments.push_back(str.substr(pos, chunk_size));
+		pos += chunk_size + (pos + chunk_size < str.size() && str[pos + chunk_size] == '\0');
+	}
+
+	return segments;
+}
+
+std::string FormatLogMessage(std::string_view message, plugify::Severity severity, const std::source_location& loc) {
+	using namespace std::chrono;
+
+	auto now = system_clock::now();
+
+	// Split into seconds + milliseconds
+	auto seconds = floor<std::chrono::seconds>(now);
+	auto ms = duration_cast<milliseconds>(now - seconds);
+
+	return std::format(
+		"[{:%F %T}.{:03d}] [{}] [{}:{}] {}\n",
+		seconds,  // %F = YYYY-MM-DD, %T = HH:MM:SS
+		static_cast<int>(ms.count()),
+		plg::enum_to_string(severity),
+		loc.file_name(),
+		loc.line(),
+		message
+	);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <plugify/logger.hpp>
+
+// ANSI Color codes
+struct Colors {
+	static constexpr char RESET = '\x01';    // SOH (Start of Heading)
+	static constexpr char WHITE = '\x01';    // SOH (Start of Heading)
+	static constexpr char RED = '\x02';      // STX (Start of Text)
+	static constexpr char GREEN = '\x03';    // ETX (End of Text)
+	static constexpr char YELLOW = '\x04';   // EOT (End of Transmission)
+	static constexpr char BLUE = '\x05';     // ENQ (Enquiry)
+	static constexpr char MAGENTA = '\x06';  // ACK (Acknowledge)
+	static constexpr char ORANGE = '\x07';   // BEL (Bell)
+	static constexpr char CYAN = '\x08';     // BS  (Backspace
+	static constexpr char GRAY = '\x0B';     // VT  (Vertical Tab)
+	static constexpr char BLACK = '\x0C';    // FF  (Form Feed)
+};
+
+class AnsiColorParser {
+public:
+	struct TextSegment {
+		std::string_view text;
+		uint8_t code;  // one of Colors, the console maps it onto an engine color
+	};
+
+	// Use bit flags to quickly check if a byte is a color code
+	static constexpr bool isColorCode[256] = {
+		false,  // 0  0x00 (unused)
+		true,   // 1  0x01 RESET
+		true,   // 2  0x02
+		true,   // 3  0x03
+		true,   // 4  0x04
+		true,   // 5  0x05
+		true,   // 6  0x06
+		true,   // 7  0x07
+		true,   // 8  0x08
+		false,  // 9  0x09 (skip - TAB)
+		false,  // 10 0x0A (skip - LF)
+		true,   // 11 0x0B
+		true,   // 12 0x0C
+		false,  // 13 0x0D (skip - CR)
+		// ... rest are false
+	};
+
+	// Splits the string at color codes, the codes are overwritten with null terminators
+	static std::vector<TextSegment> Tokenize(std::string_view str);
+
+	// Helper to strip color codes for display/logging
+	static std::string StripColors(std::string_view input);
+};
+
+// Splits a console message into chunks the engine accepts (breaking at newlines when possible).
+// The chosen newlines are overwritten with null terminators.
+std::vector<std::string_view> SplitConsoleChunks(std::string_view str, size_t max_size = 2048);
+
+// "[date time.ms] [severity] [file:line] message\n"
+std::string FormatLogMessage(std::string_view message, plugify::Severity severity, const std::source_location& loc);
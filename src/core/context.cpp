@@ -0,0 +1,38 @@
+#include "context.hpp"
+
+using namespace plugify;
+namespace fs = std::filesystem;
+
+Config::Paths BuildPaths(const fs::path& baseDir) {
+	return {
+		.baseDir = baseDir,
+		.extensionsDir = "envs",
+		.configsDir = "configs",
+		.dataDir = "data",
+		.logsDir = "logs",
+		.cacheDir = "pkgs",
+	};
+}
+
+Result<std::shared_ptr<Plugify>> CreatePlugifyContext(const fs::path& baseDir, std::shared_ptr<ILogger> logger) {
+	// Build paths
+	auto paths = BuildPaths(baseDir);
+
+	// Create context
+	auto buildResult = Plugify::CreateBuilder()
+		.WithLogger(std::move(logger))
+		.WithPaths(std::move(paths))
+		.Build();
+
+	if (!buildResult) {
+		return MakeError("Failed to create Plugify context: {}", buildResult.error());
+	}
+
+	// Initialize context
+	auto context = std::move(*buildResult);
+	if (auto result = context->Initialize(); !result) {
+		return MakeError("Failed to initialize context: {}", result.error());
+	}
+
+	return context;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+#include <plugify/logger.hpp>
+#include <plugify/plugify.hpp>
+
+// Extension layout under addons/plugify: environments double as the extensions directory
+plugify::Config::Paths BuildPaths(const std::filesystem::path& baseDir);
+
+// Builds and initializes a Plugify context rooted at baseDir, the manager is left uninitialized
+plugify::Result<std::shared_ptr<plugify::Plugify>>
+CreatePlugifyContext(const std::filesystem::path& baseDir, std::shared_ptr<plugify::ILogger> logger);
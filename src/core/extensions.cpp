@@ -0,0 +1,70 @@
+#include "extensions.hpp"
+
+using namespace plugify;
+
+std::pmr::vector<std::pmr::string> ParseCsv(std::string_view str, std::pmr::memory_resource* resource) {
+	std::pmr::vector<std::pmr::string> result(resource);
+	for (size_t pos = 0; pos <= str.size();) {
+		auto end = str.find(',', pos);
+		if (end == std::string_view::npos) {
+			end = str.size();
+		}
+		auto item = str.substr(pos, end - pos);
+		pos = end + 1;
+
+		// Trim whitespace
+		auto first = item.find_first_not_of(" \t");
+		if (first == std::string_view::npos) {
+			continue;
+		}
+		item = item.substr(first, item.find_last_not_of(" \t") - first + 1);
+		result.emplace_back(item);
+	}
+	return result;
+}
+
+SortBy ParseSortBy(std::string_view str) {
+	if (str == "name") {
+		return SortBy::Name;
+	}
+	if (str == "version") {
+		return SortBy::Version;
+	}
+	if (str == "state") {
+		return SortBy::State;
+	}
+	if (str == "language") {
+		return SortBy::Language;
+	}
+	if (str == "loadtime") {
+		return SortBy::LoadTime;
+	}
+	return SortBy::Name;
+}
+
+std::pmr::vector<ExtensionState> ParseStates(
+    const std::pmr::vector<std::pmr::string>& strs,
+    std::pmr::memory_resource* resource
+) {
+	std::pmr::vector<ExtensionState> states(resource);
+	states.reserve(strs.size());
+	for (const auto& str : strs) {
+		auto lower = ToLower(str, resource);
+
+		if (lower == "loaded") {
+			states.push_back(ExtensionState::Loaded);
+		} else if (lower == "started") {
+			states.push_back(ExtensionState::Started);
+		} else if (lower == "failed") {
+			states.push_back(ExtensionState::Failed);
+		} else if (lower == "disabled") {
+			states.push_back(ExtensionState::Disabled);
+		} else if (lower == "corrupted") {
+			states.push_back(ExtensionState::Corrupted);
+		} else if (lower == "unresolved") {
+			states.push_back(ExtensionState::Unresolved);
+		}
+		// Add more as needed
+	}
+	return states;
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glaze/glaze.hpp>
+
+#include <plugify/extension.hpp>
+
+#include <plg/enum.hpp>
+#include <plg/format.hpp>
+
+#include "arena.hpp"
+
+// Listing helpers shared by 'plugify plugins|modules'. They are templated on the extension
+// type so benchmarks can run them over synthetic sets without a manager. Temporaries come from
+// CommandArena::Get(), so inside a console command they never touch the heap.
+
+// Filter options
+struct FilterOptions {
+	std::optional<std::pmr::vector<plugify::ExtensionState>> states;
+	std::optional<std::pmr::vector<std::pmr::string>> languages;
+	std::optional<std::string> searchQuery;
+	bool showOnlyFailed = false;
+	bool showOnlyWithErrors = false;
+};
+
+// Sort options
+enum class SortBy { Name, Version, State, Language, LoadTime };
+
+// Lowercase copy allocated from the given resource
+inline std::pmr::string ToLower(std::string_view str, std::pmr::memory_resource* resource = CommandArena::Get()) {
+	std::pmr::string lower(str, resource);
+	std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+		return static_cast<char>(std::tolower(c));
+	});
+	return lower;
+}
+
+// Helper to check if extension matches filter
+template <typename Ext>
+bool MatchesFilter(const Ext* ext, const FilterOptions& filter) {
+	using plugify::ExtensionState;
+
+	if (filter.showOnlyFailed && ext->GetState() != ExtensionState::Failed) {
+		return false;
+	}
+
+	if (filter.showOnlyWithErrors && !ext->HasErrors()) {
+		return false;
+	}
+
+	if (filter.states.has_value()) {
+		auto state = ext->GetState();
+		if (std::find(filter.states->begin(), filter.states->end(), state)
+		    == filter.states->end()) {
+			return false;
+		}
+	}
+
+	if (filter.languages.has_value()) {
+		std::string_view lang = ext->GetLanguage();
+		if (std::find(filter.languages->begin(), filter.languages->end(), lang)
+		    == filter.languages->end()) {
+			return false;
+		}
+	}
+
+	if (filter.searchQuery.has_value()) {
+		auto* resource = CommandArena::Get();
+		auto query = ToLower(*filter.searchQuery, resource);
+		auto name = ToLower(ext->GetName(), resource);
+		auto desc = ToLower(ext->GetDescription(), resource);
+
+		if (name.find(query) == std::string::npos && desc.find(query) == std::string::npos) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Convert extension to JSON
+template <typename Ext>
+glz::json_t ExtensionToJson(const Ext* ext) {
+	glz::json_t j;
+	j["id"] = plugify::UniqueId::Value{ ext->GetId() };
+	j["name"] = ext->GetName();
+	j["version"] = ext->GetVersionString();
+	j["type"] = ext->IsPlugin() ? "plugin" : "module";
+	j["state"] = plg::enum_to_string(ext->GetState());
+	j["language"] = ext->GetLanguage();
+	j["location"] = plg::as_string(ext->GetLocation());
+
+	if (!ext->GetDescription().empty()) {
+		j["description"] = ext->GetDescription();
+	}
+	if (!ext->GetAuthor().empty()) {
+		j["author"] = ext->GetAuthor();
+	}
+	if (!ext->GetWebsite().empty()) {
+		j["website"] = ext->GetWebsite();
+	}
+	if (!ext->GetLicense().empty()) {
+		j["license"] = ext->GetLicense();
+	}
+
+	// Dependencies
+	if (!ext->GetDependencies().empty()) {
+		glz::json_t::array_t dependencies;
+		for (const auto& dep : ext->GetDependencies()) {
+			glz::json_t::object_t depJson;
+			depJson["name"] = dep.GetName();
+			depJson["constraints"] = dep.GetConstraints().to_string();
+			depJson["optional"] = dep.IsOptional();
+			dependencies.emplace_back(std::move(depJson));
+		}
+		j["dependencies"] = glz::json_t::array_t{ std::move(dependencies) };
+	}
+
+	// Performance
+	j["performance"]["total_time_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+	                                        ext->GetTotalTime()
+	)
+	                                        .count();
+
+	// Errors and warnings
+	if (ext->HasErrors()) {
+		glz::json_t::array_t errors;
+		errors.reserve(ext->GetErrors().size());
+		for (const auto& error : ext->GetErrors()) {
+			errors.emplace_back(error);
+		}
+		j["errors"] = glz::json_t::array_t{ std::move(errors) };
+	}
+	if (ext->HasWarnings()) {
+		glz::json_t::array_t warnings;
+		warnings.reserve(ext->GetWarnings().size());
+		for (const auto& warning : ext->GetWarnings()) {
+			warnings.emplace_back(warning);
+		}
+		j["warnings"] = glz::json_t::array_t{ std::move(warnings) };
+	}
+
+	return j;
+}
+
+// Filter extensions based on criteria
+template <typename Ext, typename Alloc>
+std::pmr::vector<const Ext*> FilterExtensions(
+    const std::vector<const Ext*, Alloc>& extensions,
+    const FilterOptions& filter,
+    std::pmr::memory_resource* resource = CommandArena::Get()
+) {
+	std::pmr::vector<const Ext*> result(resource);
+	result.reserve(extensions.size());
+
+	for (const auto& ext : extensions) {
+		if (!MatchesFilter(ext, filter)) {
+			continue;
+		}
+		result.push_back(ext);
+	}
+
+	return result;
+}
+
+// Sort extensions
+template <typename Ext, typename Alloc>
+void SortExtensions(std::vector<const Ext*, Alloc>& extensions, SortBy sortBy, bool reverse = false) {
+	std::sort(
+	    extensions.begin(),
+	    extensions.end(),
+	    [sortBy, reverse](const Ext* a, const Ext* b) {
+		    bool result = false;
+		    switch (sortBy) {
+			    case SortBy::Name:
+				    result = a->GetName() < b->GetName();
+				    break;
+			    case SortBy::Version:
+				    result = a->GetVersion() < b->GetVersion();
+				    break;
+			    case SortBy::State:
+				    result = a->GetState() < b->GetState();
+				    break;
+			    case SortBy::Language:
+				    result = a->GetLanguage() < b->GetLanguage();
+				    break;
+			    case SortBy::LoadTime:
+				    result = a->GetOperationTime(plugify::ExtensionState::Loaded)
+				             < b->GetOperationTime(plugify::ExtensionState::Loaded);
+				    break;
+		    }
+		    return reverse ? !result : result;
+	    }
+	);
+}
+
+// Helper function to parse comma-separated values
+std::pmr::vector<std::pmr::string> ParseCsv(std::string_view str, std::pmr::memory_resource* resource = CommandArena::Get());
+
+// Helper to parse sort option
+SortBy ParseSortBy(std::string_view str);
+
+// Helper to parse state filter
+std::pmr::vector<plugify::ExtensionState> ParseStates(
+    const std::pmr::vector<std::pmr::string>& strs,
+    std::pmr::memory_resource* resource = CommandArena::Get()
+);
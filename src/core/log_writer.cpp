@@ -0,0 +1,115 @@
+#include "log_writer.hpp"
+#include "probes.hpp"
+#include "runtime_trace.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <print>
+
+#include <plg/format.hpp>
+
+using namespace plugify;
+namespace fs = std::filesystem;
+
+Result<std::unique_ptr<LogFileWriter>> LogFileWriter::Create(const fs::path& filename, bool async) {
+	std::error_code ec;
+	fs::create_directories(filename.parent_path(), ec);
+
+	errno = 0;
+	std::ofstream file(filename, std::ios::app);
+	if (!file) {
+		return MakeError(
+		    "Failed to open log file: {} - {}",
+		    plg::as_string(filename),
+		    std::strerror(errno)
+		);
+	}
+
+	return std::make_unique<LogFileWriter>(std::move(file), async);
+}
+
+LogFileWriter::LogFileWriter(std::ofstream&& file, bool async)
+    : _async(async)
+    , _running(true)
+    , _file(std::move(file)) {
+	if (_async) {
+		_worker_thread = std::thread(&LogFileWriter::ProcessQueue, this);
+	}
+}
+
+LogFileWriter::~LogFileWriter() {
+	if (_async) {
+		Stop();
+	}
+	_file.close();
+}
+
+void LogFileWriter::Append(std::string_view message) {
+	if (message.ends_with('\n')) {
+		message = message.substr(0, message.size() - 1);
+	}
+	if (message.empty()) {
+		return;
+	}
+
+	auto now = std::chrono::system_clock::now();
+	auto seconds = std::chrono::floor<std::chrono::seconds>(now);
+
+	std::string formatted_message;
+	try {
+		std::chrono::zoned_time zt{ std::chrono::current_zone(), seconds };
+		formatted_message = std::format("[{:%Y%m%d_%H%M%S}] {}", zt, message);
+	} catch (const std::exception&) {
+		// Fallback to UTC if local timezone fails
+		formatted_message = std::format(
+		    "[{:%Y%m%d_%H%M%S}] {}",
+		    std::chrono::utc_clock::from_sys(seconds),
+		    message
+		);
+	}
+
+	if (_async) {
+		{
+			std::lock_guard lock(_queue_mutex);
+			S2_PROBE1(log__enqueue, formatted_message.size());
+			_message_queue.emplace(std::move(formatted_message));
+		}
+		_condition.notify_one();
+	} else {
+		Write(formatted_message);
+	}
+}
+
+void LogFileWriter::Write(const std::string& message) {
+	RuntimeTraceScope trace("FileWrite", "logging", static_cast<int64_t>(message.size()));
+	S2_PROBE1(log__write__begin, message.size());
+	std::lock_guard lock(_file_mutex);
+	std::println(_file, "{}", message);
+	_file.flush();
+	S2_PROBE1(log__write__end, message.size());
+}
+
+void LogFileWriter::ProcessQueue() {
+	while (_running) {
+		std::unique_lock lock(_queue_mutex);
+		_condition.wait(lock, [this] { return !_message_queue.empty() || !_running; });
+
+		while (!_message_queue.empty()) {
+			auto message = std::move(_message_queue.front());
+			_message_queue.pop();
+			lock.unlock();
+			Write(message);
+			lock.lock();
+		}
+	}
+}
+
+void LogFileWriter::Stop() {
+	_running = false;
+	_condition.notify_one();
+	if (_worker_thread.joinable()) {
+		_worker_thread.join();
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <plugify/plugify.hpp>
+
+// Appends timestamped lines to the session log, optionally from a background thread.
+// Engine log listeners forward their messages here.
+class LogFileWriter {
+public:
+	static plugify::Result<std::unique_ptr<LogFileWriter>>
+	Create(const std::filesystem::path& filename, bool async = true);
+
+	explicit LogFileWriter(std::ofstream&& file, bool async = true);
+	~LogFileWriter();
+
+	LogFileWriter(const LogFileWriter&) = delete;
+	LogFileWriter& operator=(const LogFileWriter&) = delete;
+
+	// Drops one trailing newline and ignores empty messages
+	void Append(std::string_view message);
+
+private:
+	bool _async;
+	std::atomic<bool> _running;
+	std::mutex _queue_mutex;
+	std::queue<std::string> _message_queue;
+	std::condition_variable _condition;
+	std::thread _worker_thread;
+	std::mutex _file_mutex;
+	std::ofstream _file;
+
+	void Write(const std::string& message);
+	void ProcessQueue();
+	void Stop();
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+// USDT probes for bpftrace/SystemTap (provider "plugify"), a single nop when not attached.
+// S2_USDT is set by CMake when <sys/sdt.h> was found, configure with -DS2_USDT=ON to require it.
+#if S2_PLATFORM_LINUX && defined(S2_USDT)
+#include <sys/sdt.h>
+#define S2_PROBE(name) DTRACE_PROBE(plugify, name)
+#define S2_PROBE1(name, a) DTRACE_PROBE1(plugify, name, a)
+#define S2_PROBE2(name, a, b) DTRACE_PROBE2(plugify, name, a, b)
+#else
+#define S2_PROBE(name)
+#define S2_PROBE1(name, a)
+#define S2_PROBE2(name, a, b)
+#endif
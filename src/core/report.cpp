@@ -0,0 +1,188 @@
+#include "report.hpp"
+
+#include <algorithm>
+
+namespace {
+	bool IsColorCode(char c) {
+		auto byte = static_cast<unsigned char>(c);
+		return byte < 32 && AnsiColorParser::isColorCode[byte];
+	}
+
+	bool IsLeadByte(char c) {
+		return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+	}
+
+	// Byte length of the longest prefix that fits in 'width' cells, colors do not count
+	size_t PrefixForWidth(std::string_view text, size_t width, bool& colored) {
+		size_t cells = 0;
+		for (size_t i = 0; i < text.size(); ++i) {
+			char c = text[i];
+			if (IsColorCode(c)) {
+				colored = true;
+			} else if (IsLeadByte(c)) {
+				if (cells == width) {
+					return i;
+				}
+				++cells;
+			}
+		}
+		return text.size();
+	}
+}
+
+size_t DisplayWidth(std::string_view text) {
+	size_t width = 0;
+	for (char c : text) {
+		if (!IsColorCode(c) && IsLeadByte(c)) {
+			++width;
+		}
+	}
+	return width;
+}
+
+ReportBuffer& ReportBuffer::Append(std::string_view text, char color) {
+	if (color) {
+		_buffer.push_back(color);
+		_buffer.append(text);
+		_buffer.push_back(Colors::RESET);
+	} else {
+		_buffer.append(text);
+	}
+	return *this;
+}
+
+size_t CountLines(std::string_view text) {
+	auto lines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+	return lines + (!text.empty() && text.back() != '\n');
+}
+
+std::string_view SliceLines(std::string_view text, size_t offset, size_t limit) {
+	size_t begin = 0;
+	for (; offset > 0 && begin < text.size(); --offset) {
+		auto newline = text.find('\n', begin);
+		begin = newline == std::string_view::npos ? text.size() : newline + 1;
+	}
+	if (!limit) {
+		return text.substr(begin);
+	}
+	size_t end = begin;
+	for (; limit > 0 && end < text.size(); --limit) {
+		auto newline = text.find('\n', end);
+		end = newline == std::string_view::npos ? text.size() : newline + 1;
+	}
+	return text.substr(begin, end - begin);
+}
+
+ReportBuffer& ReportBuffer::PadMeasured(std::string_view text, size_t length, size_t width, char color, bool fill) {
+	if (length > width) {
+		constexpr std::string_view ellipsis = "...";
+		bool colored = false;
+		auto keep = width > ellipsis.size() ? width - ellipsis.size() : 0;
+		auto prefix = text.substr(0, PrefixForWidth(text, keep, colored));
+		if (color) {
+			_buffer.push_back(color);
+		}
+		_buffer.append(prefix);
+		_buffer.append(ellipsis.substr(0, width - keep));
+		if (color || colored) {
+			_buffer.push_back(Colors::RESET);
+		}
+		return *this;
+	}
+
+	Append(text, color);
+	if (fill) {
+		_buffer.append(width - length, ' ');
+	}
+	return *this;
+}
+
+Table& Table::Append(std::string_view text, char color) {
+	if (_entries.empty()) {
+		Cell();
+	}
+	if (color) {
+		_text.push_back(color);
+		_text.append(text);
+		_text.push_back(Colors::RESET);
+	} else {
+		_text.append(text);
+	}
+	auto& entry = _entries.back();
+	entry.size = static_cast<uint32_t>(_text.size() - entry.offset);
+	entry.width += static_cast<uint32_t>(DisplayWidth(text));
+	return *this;
+}
+
+Table& Table::Note(std::string_view label, char color, std::string_view text) {
+	Entry entry{ static_cast<uint32_t>(_text.size()), 0, 0, true };
+	_text.append("     └─ ");
+	_text.push_back(color);
+	_text.append(label);
+	_text.push_back(Colors::RESET);
+	_text.append(": ");
+	_text.append(text);
+	entry.size = static_cast<uint32_t>(_text.size() - entry.offset);
+	_entries.push_back(entry);
+	return *this;
+}
+
+void Table::Render(ReportBuffer& out, std::string_view rule) const {
+	const size_t count = _columns.size();
+	if (!count) {
+		return;
+	}
+
+	std::vector<size_t> widths(count);
+	for (size_t i = 0; i < count; ++i) {
+		widths[i] = DisplayWidth(_columns[i].header);
+	}
+	size_t column = 0;
+	for (const auto& entry : _entries) {
+		if (entry.note) {
+			continue;
+		}
+		widths[column] = std::max<size_t>(widths[column], entry.width);
+		column = (column + 1) % count;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		if (_columns[i].maxWidth) {
+			widths[i] = std::min(widths[i], _columns[i].maxWidth);
+		}
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		if (i) {
+			out.Spaces(1);
+		}
+		out.Pad(_columns[i].header, widths[i], _columns[i].color, i + 1 < count);
+	}
+	out.Line();
+	if (!rule.empty()) {
+		out.Line(rule);
+	}
+
+	column = 0;
+	for (const auto& entry : _entries) {
+		std::string_view text(_text.data() + entry.offset, entry.size);
+		if (entry.note) {
+			if (column) {
+				out.Line();
+				column = 0;
+			}
+			out.Line(text);
+			continue;
+		}
+		if (column) {
+			out.Spaces(1);
+		}
+		out.PadMeasured(text, entry.width, widths[column], 0, column + 1 < count);
+		if (++column == count) {
+			out.Line();
+			column = 0;
+		}
+	}
+	if (column) {
+		out.Line();
+	}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "console.hpp"
+
+// Console width of a string: color codes are skipped and every UTF-8 sequence counts as one cell
+size_t DisplayWidth(std::string_view text);
+
+// Number of lines, a final line without a newline counts
+size_t CountLines(std::string_view text);
+
+// Lines [offset, offset + limit) of the text, limit 0 keeps the rest
+std::string_view SliceLines(std::string_view text, size_t offset, size_t limit);
+
+// Builds a whole console report in one growable buffer. Color codes and padding are appended
+// in place, so a report costs one allocation (usually none past the first) and is handed to the
+// logger with a single call instead of one plg::print per line.
+class ReportBuffer {
+public:
+	explicit ReportBuffer(size_t capacity = 4096) {
+		_buffer.reserve(capacity);
+	}
+
+	// Appends text, wrapped in the color and a reset when one is given
+	ReportBuffer& Append(std::string_view text, char color = 0);
+
+	// Appends text left-aligned in a column of 'width' cells, truncated with "..." when longer.
+	// Without 'fill' the trailing padding is skipped (last column of a line).
+	ReportBuffer& Pad(std::string_view text, size_t width, char color = 0, bool fill = true) {
+		return PadMeasured(text, DisplayWidth(text), width, color, fill);
+	}
+
+	// Pad for text whose display width is already known
+	ReportBuffer& PadMeasured(std::string_view text, size_t length, size_t width, char color = 0, bool fill = true);
+
+	ReportBuffer& Spaces(size_t count) {
+		_buffer.append(count, ' ');
+		return *this;
+	}
+
+	template <typename... Args>
+	ReportBuffer& Format(std::format_string<Args...> fmt, Args&&... args) {
+		std::format_to(std::back_inserter(_buffer), fmt, std::forward<Args>(args)...);
+		return *this;
+	}
+
+	template <typename... Args>
+	ReportBuffer& FormatColor(char color, std::format_string<Args...> fmt, Args&&... args) {
+		_buffer.push_back(color);
+		std::format_to(std::back_inserter(_buffer), fmt, std::forward<Args>(args)...);
+		_buffer.push_back(Colors::RESET);
+		return *this;
+	}
+
+	ReportBuffer& Line(std::string_view text = {}, char color = 0) {
+		Append(text, color);
+		_buffer.push_back('\n');
+		return *this;
+	}
+
+	// "  <label padded> <value>" line used by the detail views
+	ReportBuffer& Field(std::string_view label, std::string_view value, char color = 0) {
+		Spaces(2).Pad(label, kLabelWidth, Colors::GRAY).Spaces(1);
+		return Line(value, color);
+	}
+
+	bool Empty() const {
+		return _buffer.empty();
+	}
+
+	size_t Size() const {
+		return _buffer.size();
+	}
+
+	std::string_view View() const {
+		return _buffer;
+	}
+
+	std::string Take() {
+		return std::move(_buffer);
+	}
+
+	static constexpr size_t kLabelWidth = 14;
+
+private:
+	std::string _buffer;
+};
+
+// Column layout for a ReportBuffer. Cells are copied into one text buffer as they are added, their
+// widths are measured once on insertion, and Render pads every column to its widest cell.
+class Table {
+public:
+	struct Column {
+		std::string_view header;
+		size_t maxWidth = 0;  // 0 = unbounded, wider cells are truncated with "..."
+		char color = Colors::GRAY;
+	};
+
+	Table(std::initializer_list<Column> columns)
+	    : _columns(columns) {
+	}
+
+	// Starts the next cell, rows wrap after the last column
+	Table& Cell() {
+		_entries.push_back({ static_cast<uint32_t>(_text.size()), 0, 0, false });
+		++_cells;
+		return *this;
+	}
+
+	Table& Cell(std::string_view text, char color = 0) {
+		return Cell().Append(text, color);
+	}
+
+	Table& Cell(size_t value) {
+		char digits[24];
+		auto end = std::to_chars(std::begin(digits), std::end(digits), value).ptr;
+		return Cell(std::string_view(digits, static_cast<size_t>(end - digits)));
+	}
+
+	// Extends the current cell, so one cell can hold several colors
+	Table& Append(std::string_view text, char color = 0);
+
+	// Full-width line under the row just completed ("     └─ label: text"), outside the column layout
+	Table& Note(std::string_view label, char color, std::string_view text);
+
+	size_t Rows() const {
+		return _columns.empty() ? 0 : _cells / _columns.size();
+	}
+
+	// Writes the header, the optional rule under it and every row
+	void Render(ReportBuffer& out, std::string_view rule = {}) const;
+
+private:
+	struct Entry {
+		uint32_t offset;
+		uint32_t size;
+		uint32_t width;
+		bool note;
+	};
+
+	std::vector<Column> _columns;
+	std::vector<Entry> _entries;
+	std::string _text;
+	size_t _cells = 0;
+};
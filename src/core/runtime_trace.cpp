@@ -0,0 +1,93 @@
+#include "runtime_trace.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+
+#include <plg/format.hpp>
+
+using namespace plugify;
+namespace fs = std::filesystem;
+
+Result<RuntimeTrace::Summary> RuntimeTrace::Stop(const fs::path& path) {
+	if (!_enabled.exchange(false, std::memory_order_acq_rel)) {
+		return MakeError("Trace capture is not running");
+	}
+
+	auto generation = _generation.load(std::memory_order_acquire);
+
+	Summary summary;
+	std::string out;
+	out.reserve(1 << 20);
+	out += R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+	bool first = true;
+	std::scoped_lock lock(_registryMutex);
+	for (const auto& buffer : _buffers) {
+		if (buffer->generation.load(std::memory_order_acquire) != generation) {
+			continue;
+		}
+		auto size = std::min(buffer->size.load(std::memory_order_acquire), kBufferEvents);
+		summary.dropped += buffer->dropped.load(std::memory_order_relaxed);
+		if (size == 0) {
+			continue;
+		}
+		++summary.threads;
+		summary.events += size;
+
+		std::format_to(
+		    std::back_inserter(out),
+		    R"({}{{"ph":"M","name":"thread_name","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+		    first ? "" : ",",
+		    buffer->tid,
+		    buffer->tid == _gameTid ? "game" : "worker"
+		);
+		first = false;
+
+		for (size_t i = 0; i < size; ++i) {
+			const auto& event = buffer->events[i];
+			if (event.dur < 0) {
+				std::format_to(
+				    std::back_inserter(out),
+				    R"(,{{"ph":"i","s":"t","name":"{}","cat":"{}","pid":1,"tid":{},"ts":{:.3f})",
+				    event.name,
+				    event.category,
+				    buffer->tid,
+				    static_cast<double>(event.ts) / 1000.0
+				);
+			} else {
+				std::format_to(
+				    std::back_inserter(out),
+				    R"(,{{"ph":"X","name":"{}","cat":"{}","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f})",
+				    event.name,
+				    event.category,
+				    buffer->tid,
+				    static_cast<double>(event.ts) / 1000.0,
+				    static_cast<double>(event.dur) / 1000.0
+				);
+			}
+			if (event.arg != 0) {
+				std::format_to(std::back_inserter(out), R"(,"args":{{"value":{}}})", event.arg);
+			}
+			out += '}';
+		}
+	}
+	out += "]}";
+
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+
+	errno = 0;
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		return MakeError(
+		    "Failed to open trace file: {} - {}",
+		    plg::as_string(path),
+		    std::strerror(errno)
+		);
+	}
+	file.write(out.data(), static_cast<std::streamsize>(out.size()));
+
+	return summary;
+}
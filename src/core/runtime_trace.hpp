@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <plugify/plugify.hpp>
+
+// Runtime trace capture ('plugify trace start|stop').
+// Every thread appends into its own fixed-size buffer without locking, a disabled probe costs
+// a single relaxed load. Buffers are reset lazily by their owner when a new session starts.
+class RuntimeTrace {
+public:
+	struct Event {
+		const char* name;      // string literal
+		const char* category;  // string literal
+		int64_t ts;            // ns since session start
+		int64_t dur;           // ns, -1 for instant events
+		int64_t arg;
+	};
+
+	static constexpr size_t kBufferEvents = 1 << 16;
+
+	static bool IsEnabled() {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	static int64_t Now() {
+		return std::chrono::steady_clock::now().time_since_epoch().count()
+		       - _origin.load(std::memory_order_relaxed);
+	}
+
+	static void Complete(const char* name, const char* category, int64_t start, int64_t arg = 0) {
+		Record({ name, category, start, Now() - start, arg });
+	}
+
+	static void Instant(const char* name, const char* category, int64_t arg = 0) {
+		Record({ name, category, Now(), -1, arg });
+	}
+
+	static bool Start(std::chrono::seconds duration) {
+		if (IsEnabled()) {
+			return false;
+		}
+		auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+		_origin.store(now, std::memory_order_relaxed);
+		_deadline.store(
+		    duration.count() > 0
+		        ? now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration).count()
+		        : 0,
+		    std::memory_order_relaxed
+		);
+		_generation.fetch_add(1, std::memory_order_acq_rel);
+		_enabled.store(true, std::memory_order_release);
+		return true;
+	}
+
+	static bool Expired() {
+		auto deadline = _deadline.load(std::memory_order_relaxed);
+		return deadline != 0 && std::chrono::steady_clock::now().time_since_epoch().count() >= deadline;
+	}
+
+	struct Summary {
+		size_t events{};
+		size_t dropped{};
+		size_t threads{};
+	};
+
+	// Stops the session and writes a Chrome/Perfetto JSON trace
+	static plugify::Result<Summary> Stop(const std::filesystem::path& path);
+
+	// Must be called from the game thread to label its track
+	static void SetGameThread() {
+		_gameTid = Local()->tid;
+	}
+
+private:
+	struct ThreadBuffer {
+		std::unique_ptr<Event[]> events = std::make_unique<Event[]>(kBufferEvents);
+		std::atomic<size_t> size{ 0 };
+		std::atomic<size_t> dropped{ 0 };
+		std::atomic<uint64_t> generation{ 0 };
+		uint32_t tid{};
+	};
+
+	static void Record(const Event& event) {
+		if (!IsEnabled()) {
+			return;
+		}
+		auto* buffer = Local();
+		auto generation = _generation.load(std::memory_order_acquire);
+		if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+			buffer->size.store(0, std::memory_order_relaxed);
+			buffer->dropped.store(0, std::memory_order_relaxed);
+			buffer->generation.store(generation, std::memory_order_release);
+		}
+		auto index = buffer->size.load(std::memory_order_relaxed);
+		if (index >= kBufferEvents) {
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		buffer->events[index] = event;
+		buffer->size.store(index + 1, std::memory_order_release);
+	}
+
+	static ThreadBuffer* Local() {
+		thread_local ThreadBuffer* buffer = [] {
+			auto owned = std::make_unique<ThreadBuffer>();
+			std::scoped_lock lock(_registryMutex);
+			owned->tid = static_cast<uint32_t>(_buffers.size() + 1);
+			return _buffers.emplace_back(std::move(owned)).get();
+		}();
+		return buffer;
+	}
+
+	inline static std::atomic<bool> _enabled{ false };
+	inline static std::atomic<uint64_t> _generation{ 0 };
+	inline static std::atomic<std::chrono::steady_clock::rep> _origin{ 0 };
+	inline static std::atomic<std::chrono::steady_clock::rep> _deadline{ 0 };
+	inline static uint32_t _gameTid{};
+	inline static std::mutex _registryMutex;
+	inline static std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+};
+
+class RuntimeTraceScope {
+public:
+	RuntimeTraceScope(const char* name, const char* category, int64_t arg = 0)
+	    : _name(name)
+	    , _category(category)
+	    , _arg(arg)
+	    , _start(RuntimeTrace::IsEnabled() ? RuntimeTrace::Now() : -1) {
+	}
+
+	~RuntimeTraceScope() {
+		if (_start >= 0) {
+			RuntimeTrace::Complete(_name, _category, _start, _arg);
+		}
+	}
+
+	RuntimeTraceScope(const RuntimeTraceScope&) = delete;
+	RuntimeTraceScope& operator=(const RuntimeTraceScope&) = delete;
+
+private:
+	const char* _name;
+	const char* _category;
+	int64_t _arg;
+	int64_t _start;
+};
@@ -1,9 +1,16 @@
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <memory_resource>
 #include <queue>
+#include <set>
 #include <thread>
 #include <print>
+#include <unordered_map>
 #include <unordered_set>
 
 #if S2_PLATFORM_WINDOWS
@@ -12,12 +19,30 @@
 #undef FormatMessage
 #else
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <cstdlib>
 #endif
 
+#if S2_PLATFORM_LINUX
+#include <cxxabi.h>
+#include <link.h>
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+#include <client/annotation.h>
 #include <client/crash_report_database.h>
 #include <client/crashpad_client.h>
 #include <client/settings.h>
+#include <client/simulate_crash.h>
 
 #include <dynlibutils/module.hpp>
 #include <dynlibutils/virtual.hpp>
@@ -37,6 +62,16 @@
 #include <plg/enum.hpp>
 #include <plg/format.hpp>
 
+#include "core/arena.hpp"
+#include "core/command_log.hpp"
+#include "core/console.hpp"
+#include "core/context.hpp"
+#include "core/extensions.hpp"
+#include "core/log_writer.hpp"
+#include "core/probes.hpp"
+#include "core/report.hpp"
+#include "core/runtime_trace.hpp"
+
 #include <eiface.h>
 #include <convar.h>
 #include <igamesystem.h>
@@ -97,2255 +132,5723 @@ namespace {
 	// 31 0x1F  US   (Unit Separator)          ✅ Safe to use
 }
 
-// ANSI Color codes
-struct Colors {
-	static constexpr char RESET = '\x01';    // SOH (Start of Heading)
-	static constexpr char WHITE = '\x01';    // SOH (Start of Heading)
-	static constexpr char RED = '\x02';      // STX (Start of Text)
-	static constexpr char GREEN = '\x03';    // ETX (End of Text)
-	static constexpr char YELLOW = '\x04';   // EOT (End of Transmission)
-	static constexpr char BLUE = '\x05';     // ENQ (Enquiry)
-	static constexpr char MAGENTA = '\x06';  // ACK (Acknowledge)
-	static constexpr char ORANGE = '\x07';   // BEL (Bell)
-	static constexpr char CYAN = '\x08';     // BS  (Backspace
-	static constexpr char GRAY = '\x0B';     // VT  (Vertical Tab)
-	static constexpr char BLACK = '\x0C';    // FF  (Form Feed)
-};
 
-class AnsiColorParser {
+// Fixed-size binary ring of recent launcher events. It is mapped onto a file so the contents
+// survive a crash and can be attached to the report next to the session log. Writers only
+// perform relaxed atomic stores; every slot carries a sequence number so a reader can drop
+// records that were overwritten while it was copying them.
+class FlightRecorder {
 public:
-	struct TextSegment {
-		std::string_view text;
-		Color color;
+	enum class EventType : uint16_t {
+		None,
+		State,      // code = command type, arg = 0 on begin or 1 + status on end, value = elapsed µs
+		Command,    // text = console command line
+		Extension,  // code = extension state, text = extension name
+		Log,        // code = severity, text = message prefix
+		Stall,      // code = 1 when the watchdog terminated, value = stalled ms, text = owning extension
 	};
 
-	// Use bit flags to quickly check if a byte is a color code
-	static constexpr bool isColorCode[256] = {
-		false,  // 0  0x00 (unused)
-		true,   // 1  0x01 RESET
-		true,   // 2  0x02
-		true,   // 3  0x03
-		true,   // 4  0x04
-		true,   // 5  0x05
-		true,   // 6  0x06
-		true,   // 7  0x07
-		true,   // 8  0x08
-		false,  // 9  0x09 (skip - TAB)
-		false,  // 10 0x0A (skip - LF)
-		true,   // 11 0x0B
-		true,   // 12 0x0C
-		false,  // 13 0x0D (skip - CR)
-		// ... rest are false
+	static constexpr uint32_t kDefaultCapacity = 4096;
+	static constexpr uint32_t kTickCapacity = 256;
+	static constexpr size_t kSeverities = 8;
+	static constexpr size_t kTextSize = 32;
+
+	struct Event {
+		uint64_t sequence;
+		std::chrono::nanoseconds time;  // since session start
+		EventType type;
+		uint16_t code;
+		uint32_t arg;
+		uint64_t value;
+		std::string text;
 	};
 
-	inline static Color colorMap[256] = {
-		S2Colors::WHITE,    // 0  0x00 (unused)
-		S2Colors::WHITE,    // 1  0x01 RESET
-		S2Colors::RED,      // 2  0x02
-		S2Colors::GREEN,    // 3  0x03
-		S2Colors::YELLOW,   // 4  0x04
-		S2Colors::BLUE,     // 5  0x05
-		S2Colors::MAGENTA,  // 6  0x06
-		S2Colors::ORANGE,   // 7  0x07
-		S2Colors::CYAN,     // 8  0x08
-		S2Colors::WHITE,    // 9  0x09 (skip - TAB)
-		S2Colors::WHITE,    // 10 0x0A (skip - LF)
-		S2Colors::GRAY,     // 11 0x0B
-		S2Colors::BLACK,    // 12 0x0C
-		S2Colors::WHITE,    // 13 0x0D (skip - CR)
-		// ... etc
+	struct Snapshot {
+		std::chrono::system_clock::time_point start;
+		uint32_t capacity = 0;
+		uint64_t recorded = 0;
+		uint64_t ticks = 0;
+		std::array<uint64_t, kSeverities> severities{};
+		std::vector<uint32_t> tickDurations;  // µs, oldest first
+		std::vector<Event> events;            // oldest first
 	};
 
-	static std::vector<TextSegment> Tokenize(std::string_view str) {
-		std::vector<TextSegment> segments;
-
-		Color current_color = S2Colors::WHITE;
-		size_t text_start = 0;
-
-		for (size_t i = 0; i < str.length(); ++i) {
-			auto byte = static_cast<unsigned char>(str[i]);
-			if (byte < 32 && isColorCode[byte]) {
-				const_cast<char&>(str[i]) = '\0';  // Null-terminate at color
+	// An empty path keeps the ring in memory only, so it can still be inspected live
+	static Result<void> Open(const fs::path& path, uint32_t capacity = kDefaultCapacity) {
+		Close();
+		if (capacity == 0) {
+			return {};
+		}
 
-				// Found color code
-				if (i > text_start) {
-					segments.emplace_back(str.substr(text_start, i - text_start), current_color);
-				}
+		size_t size = sizeof(Header) + sizeof(Slot) * capacity;
+		void* memory = nullptr;
 
-				current_color = colorMap[byte];
-				text_start = i + 1;
+		if (path.empty()) {
+			_heap = std::make_unique<std::byte[]>(size);
+			memory = _heap.get();
+		} else {
+			std::error_code ec;
+			fs::create_directories(path.parent_path(), ec);
+#if S2_PLATFORM_WINDOWS
+			HANDLE file = CreateFileW(
+			    path.c_str(),
+			    GENERIC_READ | GENERIC_WRITE,
+			    FILE_SHARE_READ | FILE_SHARE_WRITE,
+			    nullptr,
+			    CREATE_ALWAYS,
+			    FILE_ATTRIBUTE_NORMAL,
+			    nullptr
+			);
+			if (file == INVALID_HANDLE_VALUE) {
+				return MakeError("Failed to create flight recorder file: {}", plg::as_string(path));
 			}
-		}
+			HANDLE mapping = CreateFileMappingW(
+			    file,
+			    nullptr,
+			    PAGE_READWRITE,
+			    static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+			    static_cast<DWORD>(size & 0xFFFFFFFF),
+			    nullptr
+			);
+			CloseHandle(file);
+			if (!mapping) {
+				return MakeError("Failed to map flight recorder file: {}", plg::as_string(path));
+			}
+			memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+			CloseHandle(mapping);
+			if (!memory) {
+				return MakeError("Failed to map flight recorder file: {}", plg::as_string(path));
+			}
+#else
+			int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if (fd < 0) {
+				return MakeError(
+				    "Failed to create flight recorder file: {} - {}",
+				    plg::as_string(path),
+				    std::strerror(errno)
+				);
+			}
+			if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+				int error = errno;
+				::close(fd);
+				return MakeError("Failed to size flight recorder file: {}", std::strerror(error));
+			}
+			memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (memory == MAP_FAILED) {
+				return MakeError("Failed to map flight recorder file: {}", std::strerror(errno));
+			}
+#endif
+			_mapped = memory;
+			_mappedSize = size;
+		}
+
+		auto* header = new (memory) Header{};
+		std::memcpy(header->magic, kMagic, sizeof(header->magic));
+		header->version = kVersion;
+		header->capacity = capacity;
+		header->tickCapacity = kTickCapacity;
+		header->slotSize = sizeof(Slot);
+		header->start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::system_clock::now().time_since_epoch()
+		).count();
+		std::uninitialized_value_construct_n(reinterpret_cast<Slot*>(header + 1), capacity);
+
+		_path = path;
+		_origin = std::chrono::steady_clock::now();
+		_header.store(header, std::memory_order_release);
+		return {};
+	}
 
-		// Add remaining text
-		if (text_start < str.length()) {
-			segments.emplace_back(str.substr(text_start), current_color);
+	static void Close() {
+		_header.store(nullptr, std::memory_order_release);
+		if (_mapped) {
+#if S2_PLATFORM_WINDOWS
+			UnmapViewOfFile(_mapped);
+#else
+			::munmap(_mapped, _mappedSize);
+#endif
+			_mapped = nullptr;
+			_mappedSize = 0;
 		}
+		_heap.reset();
+		_path.clear();
+	}
 
-		return segments;
+	static bool IsOpen() {
+		return _header.load(std::memory_order_relaxed) != nullptr;
 	}
 
-	// Helper to strip color codes for display/logging
-	static std::string StripColors(std::string_view input) {
-		std::string result;
-		result.reserve(input.length());
+	static const fs::path& GetPath() {
+		return _path;
+	}
 
-		for (char c : input) {
-			auto byte = static_cast<unsigned char>(c);
-			if (byte >= 32 || !isColorCode[byte]) {
-				result += c;
-			}
+	static void Tick(std::chrono::microseconds duration) {
+		auto* header = _header.load(std::memory_order_acquire);
+		if (!header) {
+			return;
 		}
-
-		return result;
+		auto index = header->tickHead.fetch_add(1, std::memory_order_relaxed);
+		auto clamped = std::min<int64_t>(duration.count(), std::numeric_limits<uint32_t>::max());
+		header->ticks[index % kTickCapacity].store(static_cast<uint32_t>(clamped), std::memory_order_relaxed);
 	}
-};
 
-class ConsoleLoggger final : public ILogger {
-public:
-	explicit ConsoleLoggger(
-	    const char* name,
-	    int flags = 0,
-	    LoggingVerbosity_t verbosity = LV_DEFAULT,
-	    Color color = UNSPECIFIED_LOGGING_COLOR
-	) {
-		m_channelID = LoggingSystem_RegisterLoggingChannel(name, nullptr, flags, verbosity, color);
+	static void CountSeverity(int severity) {
+		if (auto* header = _header.load(std::memory_order_acquire)) {
+			header->severities[static_cast<size_t>(severity) % kSeverities].fetch_add(1, std::memory_order_relaxed);
+		}
 	}
 
-	~ConsoleLoggger() override = default;
-
-	void Log(std::string_view message, Color color, bool newLine) const {
-		assert((*message.end()) == 0);
-		assert(message.size() < 2048);
-		std::scoped_lock<std::mutex> lock(m_mutex);
-		LoggingSystem_Log(m_channelID, LS_MESSAGE, color, message.data());
-		if (newLine && message.back() != '\n') {
-			LoggingSystem_Log(m_channelID, LS_MESSAGE, color, "\n");
+	static void Record(EventType type, uint16_t code, uint32_t arg, uint64_t value, std::string_view text = {}) {
+		auto* header = _header.load(std::memory_order_acquire);
+		if (!header) {
+			return;
 		}
-	}
 
-	// ReSharper disable once CppPassValueParameterByConstReference
-	void Log(std::string message, bool newLine) const {
-		auto tokens = AnsiColorParser::Tokenize(message);
+		auto index = header->head.fetch_add(1, std::memory_order_relaxed);
+		auto& slot = reinterpret_cast<Slot*>(header + 1)[index % header->capacity];
 
-		std::scoped_lock<std::mutex> lock(m_mutex);
-		for (const auto& [text, color] : tokens) {
-			for (auto segments = Tokenize(text); const auto& segment : segments) {
-				LoggingSystem_Log(m_channelID, LS_MESSAGE, color, segment.data());
-			}
+		slot.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		auto elapsed = std::chrono::steady_clock::now() - _origin;
+		slot.time.store(
+		    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+		    std::memory_order_relaxed
+		);
+		slot.meta.store(
+		    static_cast<uint64_t>(type) | (static_cast<uint64_t>(code) << 16) | (static_cast<uint64_t>(arg) << 32),
+		    std::memory_order_relaxed
+		);
+		slot.value.store(value, std::memory_order_relaxed);
+
+		std::array<uint64_t, kTextSize / sizeof(uint64_t)> words{};
+		std::memcpy(words.data(), text.data(), std::min(text.size(), kTextSize));
+		for (size_t i = 0; i < words.size(); ++i) {
+			slot.text[i].store(words[i], std::memory_order_relaxed);
 		}
-		if (newLine && message.back() != '\n') {
-			LoggingSystem_Log(m_channelID, LS_MESSAGE, "\n");
+
+		slot.sequence.store(index + 1, std::memory_order_release);
+	}
+
+	// Copy of the live ring
+	static Result<Snapshot> Capture() {
+		auto* header = _header.load(std::memory_order_acquire);
+		if (!header) {
+			return MakeError("Flight recorder is not running");
 		}
+		return Decode(header, sizeof(Header) + sizeof(Slot) * header->capacity);
 	}
 
-	void Log(std::string_view message, Severity severity, [[maybe_unused]] std::source_location loc) override {
-		if (severity <= m_severity) {
-			auto output = FormatMessage(message, severity, loc);
+	// Decode a ring written by another process, e.g. attached to a crash report
+	static Result<Snapshot> Load(const fs::path& path) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return MakeError("Failed to open flight recorder file: {}", plg::as_string(path));
+		}
 
-			std::scoped_lock<std::mutex> lock(m_mutex);
-			for (auto segments = Tokenize(output); const auto& segment : segments) {
-				switch (severity) {
-					case Severity::Unknown:
-						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::WHITE, segment.data());
-						break;
-					case Severity::Fatal:
-						LoggingSystem_Log(m_channelID, LS_ERROR, S2Colors::MAGENTA, segment.data());
-						break;
-					case Severity::Error:
-						LoggingSystem_Log(m_channelID, LS_WARNING, S2Colors::RED, segment.data());
-						break;
-					case Severity::Warning:
-						LoggingSystem_Log(m_channelID, LS_WARNING, S2Colors::ORANGE, segment.data());
-						break;
-					case Severity::Info:
-						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::YELLOW, segment.data());
-						break;
-					case Severity::Debug:
-						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::GREEN, segment.data());
-						break;
-					case Severity::Verbose:
-						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::WHITE, segment.data());
-						break;
-					default:
-						break;
-				}
-			}
+		std::error_code ec;
+		auto size = fs::file_size(path, ec);
+		if (ec) {
+			return MakeError("Failed to read flight recorder file: {}", ec.message());
 		}
-	}
 
-	void SetLogLevel(Severity minSeverity) override {
-		m_severity = minSeverity;
+		// Backed by uint64_t so the atomics inside are suitably aligned
+		std::vector<uint64_t> buffer((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size));
+		if (!file) {
+			return MakeError("Failed to read flight recorder file: {}", plg::as_string(path));
+		}
+		return Decode(buffer.data(), size);
 	}
 
-	void Flush() override {
-	}
+private:
+	static constexpr char kMagic[8] = { 'P', 'L', 'G', 'F', 'L', 'I', 'T', 'E' };
+	static constexpr uint32_t kVersion = 1;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t capacity;
+		uint32_t tickCapacity;
+		uint32_t slotSize;
+		int64_t start;  // system clock, ns since epoch
+		std::atomic<uint64_t> head;
+		std::atomic<uint64_t> tickHead;
+		std::atomic<uint64_t> severities[kSeverities];
+		std::atomic<uint32_t> ticks[kTickCapacity];  // µs
+	};
 
-protected:
-	static std::string
-	FormatMessage(std::string_view message, Severity severity, const std::source_location& loc) {
-		using namespace std::chrono;
+	struct Slot {
+		std::atomic<uint64_t> sequence;  // index + 1 once complete, 0 while being written
+		std::atomic<uint64_t> time;      // ns since session start
+		std::atomic<uint64_t> meta;      // type | code << 16 | arg << 32
+		std::atomic<uint64_t> value;
+		std::atomic<uint64_t> text[kTextSize / sizeof(uint64_t)];
+	};
 
-		auto now = system_clock::now();
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "flight recorder needs lock-free 64-bit atomics");
+	static_assert(sizeof(Slot) == 64);
+	static_assert(sizeof(Header) % alignof(Slot) == 0);
 
-		// Split into seconds + milliseconds
-		auto seconds = floor<std::chrono::seconds>(now);
-		auto ms = duration_cast<milliseconds>(now - seconds);
+	static Result<Snapshot> Decode(const void* data, size_t size) {
+		if (size < sizeof(Header)) {
+			return MakeError("Flight recorder data is truncated");
+		}
 
-		return std::format(
-			"[{:%F %T}.{:03d}] [{}] [{}:{}] {}\n",
-			seconds,  // %F = YYYY-MM-DD, %T = HH:MM:SS
-			static_cast<int>(ms.count()),
-			plg::enum_to_string(severity),
-			loc.file_name(),
-			loc.line(),
-			message
+		const auto* header = static_cast<const Header*>(data);
+		if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+			return MakeError("Not a flight recorder file");
+		}
+		if (header->version != kVersion || header->slotSize != sizeof(Slot) || header->tickCapacity != kTickCapacity) {
+			return MakeError("Unsupported flight recorder version {}", header->version);
+		}
+		if (header->capacity == 0 || size < sizeof(Header) + sizeof(Slot) * header->capacity) {
+			return MakeError("Flight recorder data is truncated");
+		}
+
+		Snapshot snapshot;
+		snapshot.start = std::chrono::system_clock::time_point(
+		    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(header->start))
 		);
-	}
+		snapshot.capacity = header->capacity;
+		snapshot.recorded = header->head.load(std::memory_order_acquire);
+		snapshot.ticks = header->tickHead.load(std::memory_order_acquire);
+		for (size_t i = 0; i < kSeverities; ++i) {
+			snapshot.severities[i] = header->severities[i].load(std::memory_order_relaxed);
+		}
 
-	static std::vector<std::string_view> Tokenize(std::string_view str, size_t max_size = 2048) {
-		std::vector<std::string_view> segments;
+		uint64_t firstTick = snapshot.ticks > kTickCapacity ? snapshot.ticks - kTickCapacity : 0;
+		snapshot.tickDurations.reserve(static_cast<size_t>(snapshot.ticks - firstTick));
+		for (uint64_t i = firstTick; i < snapshot.ticks; ++i) {
+			snapshot.tickDurations.push_back(header->ticks[i % kTickCapacity].load(std::memory_order_relaxed));
+		}
 
-		for (size_t pos = 0; pos < str.size();) {
-			size_t chunk_size = std::min(max_size, str.size() - pos);
+		const auto* slots = reinterpret_cast<const Slot*>(header + 1);
+		uint64_t first = snapshot.recorded > header->capacity ? snapshot.recorded - header->capacity : 0;
+		snapshot.events.reserve(static_cast<size_t>(snapshot.recorded - first));
 
-			// Try to break at space if we're at max size and not at the end
-			if (chunk_size == max_size && pos + chunk_size < str.size()) {
-				// Look for space within the chunk
-				auto nl_pos = str.rfind('\n', pos + chunk_size - 1);
-				if (nl_pos != std::string_view::npos && nl_pos > pos) {
-					const_cast<char&>(str[nl_pos]) = '\0';  // Null-terminate at space
-					chunk_size = nl_pos - pos;
-				}
+		for (uint64_t i = first; i < snapshot.recorded; ++i) {
+			const auto& slot = slots[i % header->capacity];
+			auto sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence != i + 1) {
+				continue;
+			}
+
+			auto meta = slot.meta.load(std::memory_order_relaxed);
+			Event event{
+				.sequence = i,
+				.time = std::chrono::nanoseconds(slot.time.load(std::memory_order_relaxed)),
+				.type = static_cast<EventType>(meta & 0xFFFF),
+				.code = static_cast<uint16_t>((meta >> 16) & 0xFFFF),
+				.arg = static_cast<uint32_t>(meta >> 32),
+				.value = slot.value.load(std::memory_order_relaxed),
+			};
+
+			std::array<uint64_t, kTextSize / sizeof(uint64_t)> words;
+			for (size_t w = 0; w < words.size(); ++w) {
+				words[w] = slot.text[w].load(std::memory_order_relaxed);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+				continue;  // overwritten while copying
 			}
 
-			segments.push_back(str.substr(pos, chunk_size));
-			pos += chunk_size + (pos + chunk_size < str.size() && str[pos + chunk_size] == '\0');
+			const auto* chars = reinterpret_cast<const char*>(words.data());
+			event.text.assign(chars, strnlen(chars, kTextSize));
+			snapshot.events.push_back(std::move(event));
 		}
 
-		return segments;
+		return snapshot;
 	}
 
-private:
-	mutable std::mutex m_mutex;
-	std::atomic<Severity> m_severity{ Severity::Unknown };
-	LoggingChannelID_t m_channelID;
+	inline static std::atomic<Header*> _header{ nullptr };
+	inline static std::unique_ptr<std::byte[]> _heap;
+	inline static void* _mapped = nullptr;
+	inline static size_t _mappedSize = 0;
+	inline static fs::path _path;
+	inline static std::chrono::steady_clock::time_point _origin;
 };
 
-class FileLoggingListener final : public ILoggingListener {
+#if S2_PLATFORM_LINUX
+// Address ranges of every loaded shared object, tagged with the extension that owns it
+class ModuleIndex {
 public:
-	static Result<std::unique_ptr<FileLoggingListener>>
-	Create(const fs::path& filename, bool async = true) {
-		std::error_code ec;
-		fs::create_directories(filename.parent_path(), ec);
+	struct Range {
+		uintptr_t begin;
+		uintptr_t end;
+		std::string path;
+		std::string owner;  // extension name, empty when not part of an extension
+	};
 
-		errno = 0;
-		std::ofstream file(filename, std::ios::app);
-		if (!file) {
-			return MakeError(
-			    "Failed to open log file: {} - {}",
-			    plg::as_string(filename),
-			    std::strerror(errno)
-			);
+	static ModuleIndex Build(std::span<const Extension* const> extensions) {
+		ModuleIndex index;
+		auto& ranges = index._ranges;
+		dl_iterate_phdr(
+		    [](dl_phdr_info* info, size_t, void* data) {
+			    auto& out = *static_cast<std::vector<Range>*>(data);
+			    std::string path = info->dlpi_name && *info->dlpi_name ? info->dlpi_name : "launcher";
+			    for (int i = 0; i < info->dlpi_phnum; ++i) {
+				    const auto& phdr = info->dlpi_phdr[i];
+				    if (phdr.p_type != PT_LOAD) {
+					    continue;
+				    }
+				    auto begin = static_cast<uintptr_t>(info->dlpi_addr + phdr.p_vaddr);
+				    out.push_back({ begin, begin + phdr.p_memsz, path, {} });
+			    }
+			    return 0;
+		    },
+		    &ranges
+		);
+
+		for (const auto* ext : extensions) {
+			auto location = ext->GetLocation().lexically_normal();
+			if (location.empty()) {
+				continue;
+			}
+			for (auto& range : ranges) {
+				if (range.owner.empty() && IsWithin(fs::path(range.path).lexically_normal(), location)) {
+					range.owner = ext->GetName();
+				}
+			}
 		}
 
-		return std::make_unique<FileLoggingListener>(std::move(file), async);
+		std::ranges::sort(ranges, {}, &Range::begin);
+		return index;
 	}
 
-	explicit FileLoggingListener(std::ofstream&& file, bool async = true)
-	    : _async(async)
-	    , _running(true)
-	    , _file(std::move(file)) {
-		if (_async) {
-			_worker_thread = std::thread(&FileLoggingListener::ProcessQueue, this);
+	const Range* Find(uintptr_t pc) const {
+		auto it = std::ranges::upper_bound(_ranges, pc, {}, &Range::begin);
+		if (it == _ranges.begin()) {
+			return nullptr;
 		}
+		--it;
+		return pc < it->end ? &*it : nullptr;
 	}
 
-	~FileLoggingListener() {
-		if (_async) {
-			Stop();
+	// Innermost frame that belongs to an extension library
+	std::string_view Owner(std::span<void* const> frames) const {
+		for (auto* frame : frames) {
+			auto* range = Find(reinterpret_cast<uintptr_t>(frame));
+			if (range && !range->owner.empty()) {
+				return range->owner;
+			}
 		}
-		_file.close();
+		return {};
 	}
 
-	void Log(const LoggingContext_t* pContext, const tchar* pMessage) override {
-		if (pContext && (pContext->m_Flags & LCF_CONSOLE_ONLY) == 0) {
-			std::string_view message = pMessage;
-			if (message.ends_with('\n')) {
-				message = message.substr(0, message.size() - 1);
-			}
-			if (message.empty()) {
-				return;
+	std::string Symbolize(uintptr_t pc) const {
+		std::string_view module = "??";
+		if (auto* range = Find(pc)) {
+			module = range->path;
+			if (auto slash = module.rfind('/'); slash != std::string_view::npos) {
+				module.remove_prefix(slash + 1);
 			}
+		}
 
-			auto now = std::chrono::system_clock::now();
-			auto seconds = std::chrono::floor<std::chrono::seconds>(now);
+		Dl_info info{};
+		if (dladdr(reinterpret_cast<void*>(pc), &info) && info.dli_sname) {
+			int status = 0;
+			std::unique_ptr<char, decltype(&std::free)> demangled(
+			    abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status),
+			    &std::free
+			);
+			std::string name = status == 0 && demangled ? demangled.get() : info.dli_sname;
+			// Folded format uses ';' as separator and ' ' before the count
+			std::ranges::replace(name, ';', ':');
+			std::ranges::replace(name, ' ', '_');
+			return std::format("{}`{}", module, name);
+		}
+		if (info.dli_fbase) {
+			return std::format("{}+0x{:x}", module, pc - reinterpret_cast<uintptr_t>(info.dli_fbase));
+		}
+		return std::format("{}@0x{:x}", module, pc);
+	}
 
-			std::string formatted_message;
-			try {
-				std::chrono::zoned_time zt{ std::chrono::current_zone(), seconds };
-				formatted_message = std::format("[{:%Y%m%d_%H%M%S}] {}", zt, message);
-			} catch (const std::exception&) {
-				// Fallback to UTC if local timezone fails
-				// auto time_t = std::chrono::system_clock::to_time_t(seconds);
-				formatted_message = std::format(
-				    "[{:%Y%m%d_%H%M%S}] {}",
-				    std::chrono::utc_clock::from_sys(seconds),
-				    message
-				);
+private:
+	// Component-wise, so envs/foo does not claim envs/foobar. A trailing separator on the
+	// directory parses as an empty last element and is skipped.
+	static bool IsWithin(const fs::path& file, const fs::path& directory) {
+		auto it = file.begin();
+		for (const auto& part : directory) {
+			if (part.empty()) {
+				break;
 			}
-
-			if (_async) {
-				{
-					std::lock_guard lock(_queue_mutex);
-					_message_queue.emplace(std::move(formatted_message));
-				}
-				_condition.notify_one();
-			} else {
-				Write(formatted_message);
+			if (it == file.end() || *it != part) {
+				return false;
 			}
+			++it;
 		}
+		return true;
 	}
 
-private:
-	bool _async;
-	std::atomic<bool> _running;
-	std::mutex _queue_mutex;
-	std::queue<std::string> _message_queue;
-	std::condition_variable _condition;
-	std::thread _worker_thread;
-	std::mutex _file_mutex;
-	std::ofstream _file;
-
-	void Write(const std::string& message) {
-		std::lock_guard lock(_file_mutex);
-		std::println(_file, "{}", message);
-		_file.flush();
-	}
+	std::vector<Range> _ranges;
+};
 
-	void ProcessQueue() {
-		while (_running) {
-			std::unique_lock lock(_queue_mutex);
-			_condition.wait(lock, [this] { return !_message_queue.empty() || !_running; });
+// Frame-pointer stack walk for signal handlers. backtrace() is not async-signal-safe (it goes
+// through the unwinder and the loader lock), this only reads the interrupted registers and the
+// frame records on the thread's own stack, each one checked against bounds taken beforehand.
+// Frames compiled without frame pointers end the walk early.
+class FrameWalk {
+public:
+	struct Stack {
+		uintptr_t low = 0;
+		uintptr_t high = 0;
+	};
 
-			while (!_message_queue.empty()) {
-				auto message = std::move(_message_queue.front());
-				_message_queue.pop();
-				lock.unlock();
-				Write(message);
-				lock.lock();
+	// Must be called on the thread that will be walked, never from a handler
+	static Stack CurrentStack() {
+		Stack stack;
+		pthread_attr_t attr;
+		if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+			void* address = nullptr;
+			size_t size = 0;
+			if (pthread_attr_getstack(&attr, &address, &size) == 0) {
+				stack.low = reinterpret_cast<uintptr_t>(address);
+				stack.high = stack.low + size;
 			}
+			pthread_attr_destroy(&attr);
 		}
+		return stack;
 	}
 
-	void Stop() {
-		_running = false;
-		_condition.notify_one();
-		if (_worker_thread.joinable()) {
-			_worker_thread.join();
+	// Interrupted pc first, then one return address per frame record
+	static int Walk(const void* context, const Stack& stack, void** frames, int maxDepth) {
+		if (!context || maxDepth <= 0) {
+			return 0;
+		}
+		const auto& mcontext = static_cast<const ucontext_t*>(context)->uc_mcontext;
+#if defined(__x86_64__)
+		auto pc = static_cast<uintptr_t>(mcontext.gregs[REG_RIP]);
+		auto fp = static_cast<uintptr_t>(mcontext.gregs[REG_RBP]);
+#elif defined(__aarch64__)
+		auto pc = static_cast<uintptr_t>(mcontext.pc);
+		auto fp = static_cast<uintptr_t>(mcontext.regs[29]);
+#else
+		return 0;
+#endif
+		int depth = 0;
+		frames[depth++] = reinterpret_cast<void*>(pc);
+		while (depth < maxDepth) {
+			// A record is { caller fp, return address } and the chain only moves up the stack
+			if (fp < stack.low || fp > stack.high - 2 * sizeof(uintptr_t) || fp % alignof(uintptr_t) != 0) {
+				break;
+			}
+			const auto* record = reinterpret_cast<const uintptr_t*>(fp);
+			if (record[1] == 0) {
+				break;
+			}
+			frames[depth++] = reinterpret_cast<void*>(record[1]);
+			if (record[0] <= fp) {
+				break;
+			}
+			fp = record[0];
 		}
+		return depth;
 	}
 };
 
-enum class PlugifyState { Wait, Load, Unload, Reload };
+// SIGPROF sampler for the game thread ('plugify profile start|stop').
+// The signal handler only copies return addresses into a preallocated buffer,
+// symbolization and attribution to extensions happen when the profile is stopped.
+class SamplingProfiler {
+public:
+	static constexpr size_t kMaxDepth = 16;
+	static constexpr size_t kMaxSamples = 1 << 16;
+
+	struct Report {
+		size_t samples{};
+		size_t dropped{};
+		std::chrono::milliseconds elapsed{};
+		std::vector<std::pair<std::string, size_t>> owners;  // sorted by samples, descending
+	};
 
-std::shared_ptr<Plugify> s_plugify;
-std::shared_ptr<ConsoleLoggger> s_logger;
-std::unique_ptr<FileLoggingListener> s_listener;
-PlugifyState s_state;
-bool s_crashpad;
+	static bool IsRunning() {
+		return _running;
+	}
 
-#define BASE_PATH PLUGIFY_PATH_LITERAL("" S2_GAME_NAME "/" "addons" "/" "plugify" "/")
-#define MAMBA_PATH BASE_PATH PLUGIFY_PATH_LITERAL("bin" "/" S2_BINARY "/" S2_EXECUTABLE_PREFIX "micromamba" S2_EXECUTABLE_SUFFIX)
+	// Must be called on the thread to sample
+	static Result<void> Start(int hz) {
+		if (_running) {
+			return MakeError("Profiler is already running");
+		}
+		if (hz <= 0 || hz > 10000) {
+			return MakeError("Sampling rate must be between 1 and 10000 Hz");
+		}
 
-namespace plg {
-	/*PLUGIFY_FORCE_INLINE void print(const char* msg) {
-		s_logger->Log(msg, S2Colors::WHITE, false);
-	}
+		if (!_samples) {
+			_samples = std::make_unique<Sample[]>(kMaxSamples);
+		}
+		_count.store(0, std::memory_order_relaxed);
+		_dropped.store(0, std::memory_order_relaxed);
 
-	PLUGIFY_FORCE_INLINE void print(std::string&& msg) {
-		s_logger->Log(std::move(msg), false);
-	}
+		_stack = FrameWalk::CurrentStack();
 
-	template<typename... Args>
-	PLUGIFY_FORCE_INLINE void print(std::format_string<Args...> fmt, Args&&... args) {
-		s_logger->Log(std::format(fmt, std::forward<Args>(args)...), false);
-	}*/
+		struct sigaction action{};
+		action.sa_sigaction = &Handler;
+		action.sa_flags = SA_SIGINFO | SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		if (sigaction(SIGPROF, &action, &_previous) != 0) {
+			return MakeError("Failed to install SIGPROF handler: {}", std::strerror(errno));
+		}
 
-	PLUGIFY_FORCE_INLINE void print(const char* msg) {
-		s_logger->Log(msg, S2Colors::WHITE, true);
-	}
+		sigevent event{};
+		event.sigev_notify = SIGEV_THREAD_ID;
+		event.sigev_signo = SIGPROF;
+		event._sigev_un._tid = static_cast<pid_t>(syscall(SYS_gettid));
+		if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &_timer) != 0) {
+			auto error = errno;
+			sigaction(SIGPROF, &_previous, nullptr);
+			return MakeError("Failed to create profiling timer: {}", std::strerror(error));
+		}
 
-	PLUGIFY_FORCE_INLINE void print(std::string&& msg) {
-		s_logger->Log(std::move(msg), true);
-	}
+		auto interval = 1'000'000'000L / hz;
+		itimerspec spec{};
+		spec.it_interval.tv_sec = interval / 1'000'000'000L;
+		spec.it_interval.tv_nsec = interval % 1'000'000'000L;
+		spec.it_value = spec.it_interval;
+		if (timer_settime(_timer, 0, &spec, nullptr) != 0) {
+			auto error = errno;
+			timer_delete(_timer);
+			sigaction(SIGPROF, &_previous, nullptr);
+			return MakeError("Failed to arm profiling timer: {}", std::strerror(error));
+		}
 
-	template <typename... Args>
-	PLUGIFY_FORCE_INLINE void print(std::format_string<Args...> fmt, Args&&... args) {
-		s_logger->Log(std::format(fmt, std::forward<Args>(args)...), true);
+		_started = std::chrono::steady_clock::now();
+		_running = true;
+		return {};
 	}
-}
-
-namespace {
-	constexpr const char* SEPARATOR_LINE = "--------------------------------------------------------------------------------";
-	constexpr const char* DOUBLE_LINE = "================================================================================";
 
-	template <typename T>
-	Result<T> ReadJson(const fs::path& path) {
-		errno = 0;
-		std::ifstream file(path, std::ios::binary);
-		if (!file) {
-			return MakeError(
-				"Failed to read json file: {} - {}",
-				plg::as_string(path),
-				std::strerror(errno)
-			);
+	// Stops sampling and writes folded stacks (one "owner;outer;...;leaf count" line per stack)
+	static Result<Report> Stop(const fs::path& path, std::span<const Extension* const> extensions) {
+		if (!_running) {
+			return MakeError("Profiler is not running");
 		}
-		auto text = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
-		auto json = glz::read_jsonc<T>(text);
-		if (!json) {
-			return MakeError(glz::format_error(json.error(), text));
+
+		timer_delete(_timer);
+		sigaction(SIGPROF, &_previous, nullptr);
+		_running = false;
+
+		Report report;
+		report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		    std::chrono::steady_clock::now() - _started
+		);
+		report.samples = std::min(_count.load(std::memory_order_acquire), kMaxSamples);
+		report.dropped = _dropped.load(std::memory_order_relaxed);
+
+		auto index = ModuleIndex::Build(extensions);
+
+		std::unordered_map<uintptr_t, std::string> symbols;
+		std::unordered_map<std::string, size_t> stacks;
+		std::unordered_map<std::string, size_t> owners;
+
+		for (size_t i = 0; i < report.samples; ++i) {
+			const auto& sample = _samples[i];
+			if (sample.depth <= 0) {
+				continue;
+			}
+
+			std::span frames(sample.frames, static_cast<size_t>(sample.depth));
+
+			// The innermost frame inside an extension library owns the sample
+			auto owner = index.Owner(frames);
+			if (owner.empty()) {
+				owner = "[engine]";
+			}
+
+			std::string stack(owner);
+			for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+				auto pc = reinterpret_cast<uintptr_t>(*it);
+				auto [symbol, inserted] = symbols.try_emplace(pc);
+				if (inserted) {
+					symbol->second = index.Symbolize(pc);
+				}
+				stack += ';';
+				stack += symbol->second;
+			}
+
+			++stacks[std::move(stack)];
+			++owners[std::string(owner)];
 		}
 
-		return *json;
-	}
+		std::error_code ec;
+		fs::create_directories(path.parent_path(), ec);
 
-	using ColorCode = char;
+		errno = 0;
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			return MakeError(
+			    "Failed to open profile file: {} - {}",
+			    plg::as_string(path),
+			    std::strerror(errno)
+			);
+		}
+		for (const auto& [stack, count] : stacks) {
+			std::println(file, "{} {}", stack, count);
+		}
 
-	// Helper to apply color
-	std::string Colorize(std::string_view text, ColorCode color) {
-		return std::format("{}{}{}", color, text, Colors::RESET);
+		report.owners.assign(owners.begin(), owners.end());
+		std::ranges::sort(report.owners, std::greater{}, &std::pair<std::string, size_t>::second);
+		return report;
 	}
 
-	// Helper to format duration
-	std::string FormatDuration(std::chrono::microseconds duration) {
-		using namespace std::chrono;
-		auto ns = duration_cast<nanoseconds>(duration).count();
-		if (ns < 1000) {
-			return std::format("{}ns", ns);
-		} else if (ns < 1000000) {
-			return std::format("{:.2f}us", static_cast<double>(ns) / 1000.0);
-		} else if (ns < 1000000000) {
-			return std::format("{:.2f}ms", static_cast<double>(ns) / 1000000.0);
+private:
+	struct Sample {
+		int depth;
+		void* frames[kMaxDepth];
+	};
+
+	static void Handler(int, siginfo_t*, void* context) {
+		int savedErrno = errno;
+		auto index = _count.load(std::memory_order_relaxed);
+		if (index < kMaxSamples) {
+			auto& sample = _samples[index];
+			sample.depth = FrameWalk::Walk(context, _stack, sample.frames, static_cast<int>(kMaxDepth));
+			_count.store(index + 1, std::memory_order_release);
 		} else {
-			return std::format("{:.2f}s", static_cast<double>(ns) / 1000000000.0);
+			_dropped.fetch_add(1, std::memory_order_relaxed);
 		}
+		errno = savedErrno;
 	}
 
-	// Get state info with color
-
-	struct StateInfo {
-		std::string_view symbol;
-		ColorCode color;
-	};
-
-	struct Glyphs {
-		std::string_view Ok;
-		std::string_view Fail;
-		std::string_view Warning;
-		std::string_view Skipped;
-		std::string_view Valid;
-		std::string_view Resolving;
-		std::string_view Arrow;
-		std::string_view Number;
-		std::string_view Unknown;
-		std::string_view Missing;
-		std::string_view Equal;
-		std::string_view NotEqual;
-		std::string_view Running;
-	};
+	inline static std::unique_ptr<Sample[]> _samples;
+	inline static FrameWalk::Stack _stack;
+	inline static std::atomic<size_t> _count{ 0 };
+	inline static std::atomic<size_t> _dropped{ 0 };
+	inline static struct sigaction _previous{};
+	inline static timer_t _timer{};
+	inline static std::chrono::steady_clock::time_point _started;
+	inline static bool _running = false;
+};
+#endif
 
-	// Unicode (original)
-	inline constexpr Glyphs UnicodeGlyphs{
-		"✓", "✗", "⚠", "○", "●", "⋯", "→", "#", "?", "ℹ", "=", "≠", "⚙",
-	};
+#if S2_PLATFORM_LINUX
+// Hardware counter group read around s_plugify->Update() ('plugify perf --counters').
+// Counters are opened for the game thread only; events the kernel or the host refuses
+// are skipped, so the group degrades to whatever is available.
+class PerfCounters {
+public:
+	enum Counter : size_t { Instructions, Cycles, CacheMisses, ContextSwitches, Count };
 
-	// Plain ASCII fallback
-	inline constexpr Glyphs AsciiGlyphs{
-		"v", "x", "!", "o", "*", "...", "->", "#", "?", "i", "=", "!=", ">>",
+	struct Window {
+		std::array<uint64_t, Count> values{};
+		uint64_t ticks{};
+		std::chrono::nanoseconds elapsed{};
 	};
 
-	// selection strategy examples:
-
-	// 1) Compile-time: define USE_ASCII or USE_ASCII_ANSI in your build
-#define USE_ASCII
-#if defined(USE_ASCII)
-	inline constexpr const Glyphs& Icons = AsciiGlyphs;
-#else
-	inline constexpr const Glyphs& Icons = UnicodeGlyphs;
-#endif
+	static bool IsOpen() {
+		return !_order.empty();
+	}
 
-	StateInfo GetStateInfo(ExtensionState state) {
-		switch (state) {
-			case ExtensionState::Parsed:
-			case ExtensionState::Resolved:
-			case ExtensionState::Started:
-			case ExtensionState::Loaded:
-			case ExtensionState::Exported:
-				return { Icons.Ok, Colors::MAGENTA };
-			case ExtensionState::Failed:
-			case ExtensionState::Corrupted:
-				return { Icons.Fail, Colors::RED };
-			case ExtensionState::Unresolved:
-				return { Icons.Warning, Colors::YELLOW };
-			case ExtensionState::Disabled:
-			case ExtensionState::Skipped:
-				return { Icons.Skipped, Colors::GRAY };
-			case ExtensionState::Loading:
-			case ExtensionState::Starting:
-			case ExtensionState::Parsing:
-			case ExtensionState::Resolving:
-			case ExtensionState::Exporting:
-			case ExtensionState::Ending:
-			case ExtensionState::Terminating:
-				return { Icons.Resolving, Colors::CYAN };
-			case ExtensionState::Running:
-				return { Icons.Running, Colors::GREEN };
-			default:
-				return { Icons.Unknown, Colors::GRAY };
-		}
+	static bool Has(Counter counter) {
+		return _fds[counter] != -1;
 	}
 
-	// Helper to truncate string
-	std::string Truncate(const std::string& str, size_t maxLen) {
-		if (str.length() <= maxLen) {
-			return str;
+	// Must be called on the game thread
+	static Result<void> Open() {
+		if (IsOpen()) {
+			return {};
 		}
-		return str.substr(0, maxLen - 3) + "...";
-	}
 
-	// Format file size
-	std::uintmax_t GetSizeRecursive(const fs::path& path) {
-		namespace fs = fs;
-		std::uintmax_t totalSize = 0;
-		std::error_code ec;
+		struct Definition {
+			Counter counter;
+			uint32_t type;
+			uint64_t config;
+		};
+		constexpr Definition definitions[] = {
+			{ Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ CacheMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ ContextSwitches, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+		};
 
-		if (fs::is_regular_file(path, ec)) {
-			auto sz = fs::file_size(path, ec);
-			if (!ec) {
-				totalSize += sz;
+		int leader = -1;
+		int lastError = 0;
+		for (const auto& [counter, type, config] : definitions) {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = type;
+			attr.config = config;
+			attr.disabled = leader == -1 ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+			                   | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC));
+			if (fd == -1) {
+				lastError = errno;
+				continue;
 			}
-		} else if (fs::is_directory(path)) {
-			for (auto& entry : fs::recursive_directory_iterator(
-			         path,
-			         fs::directory_options::skip_permission_denied,
-			         ec
-			     )) {
-				if (fs::is_regular_file(entry, ec)) {
-					auto sz = fs::file_size(entry, ec);
-					if (!ec) {
-						totalSize += sz;
-					}
-				}
+			if (leader == -1) {
+				leader = fd;
 			}
+			_fds[counter] = fd;
+			_order.push_back(counter);
 		}
-		return totalSize;
-	}
 
-	std::string FormatFileSize(const fs::path& path) {
-		try {
-			auto size = GetSizeRecursive(path);
-			if (size < 1024) {
-				return std::format("{} B", size);
-			} else if (size < 1024 * 1024) {
-				return std::format("{:.1f} KB", static_cast<double>(size) / 1024.0);
-			} else if (size < 1024ull * 1024 * 1024) {
-				return std::format("{:.1f} MB", static_cast<double>(size) / (1024.0 * 1024.0));
-			} else {
-				return std::format("{:.1f} GB", static_cast<double>(size) / (1024.0 * 1024.0 * 1024.0));
+		if (leader == -1) {
+			std::string paranoid = "unknown";
+			if (std::ifstream file("/proc/sys/kernel/perf_event_paranoid"); file) {
+				file >> paranoid;
 			}
-		} catch (...) {
-			return "N/A";
-		}
-	}
-
-	UniqueId FormatId(std::string_view str) {
-		UniqueId::Value result;
-		auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
-		if (ec != std::errc{}) {
-			plg::print("{}: {}", Colorize("Error", Colors::RED), std::make_error_code(ec).message());
-			return {};
-		} else if (ptr != str.data() + str.size()) {
-			plg::print(
-			    "{}: Invalid argument: trailing characters after the valid part",
-			    Colorize("Error", Colors::RED)
+			return MakeError(
+			    "perf_event_open failed: {} (perf_event_paranoid = {})",
+			    std::strerror(lastError),
+			    paranoid
 			);
-			return {};
 		}
-		return UniqueId{ result };
+
+		ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+		_current = {};
+		_last = {};
+		_total = {};
+		_windowStart = std::chrono::steady_clock::now();
+		return {};
 	}
 
-	fs::path FormatFileName(std::string_view type, std::string_view format) {
-		using namespace std::chrono;
-		auto now = system_clock::now();
-		auto seconds = floor<std::chrono::seconds>(now);
-		auto ms = duration_cast<milliseconds>(now - seconds);  // %F = YYYY-MM-DD, %T = HH:MM:SS
-		std::string timestamp = std::format("{:%F-%T}", seconds, static_cast<int>(ms.count()));
-		for (auto& c : timestamp) {
-			if (c == ':') {
-				c = '-';
+	static void Close() {
+		for (auto& fd : _fds) {
+			if (fd != -1) {
+				::close(fd);
+				fd = -1;
 			}
 		}
-		return std::format("{}-{}.{}", type, timestamp, format);
+		_order.clear();
 	}
 
-	// Filter options
-	struct FilterOptions {
-		std::optional<std::vector<ExtensionState>> states;
-		std::optional<std::vector<std::string>> languages;
-		std::optional<std::string> searchQuery;
-		bool showOnlyFailed = false;
-		bool showOnlyWithErrors = false;
-	};
-
-	// Sort options
-	enum class SortBy { Name, Version, State, Language, LoadTime };
-
-	// Helper to check if extension matches filter
-	bool MatchesFilter(const Extension* ext, const FilterOptions& filter) {
-		if (filter.showOnlyFailed && ext->GetState() != ExtensionState::Failed) {
-			return false;
-		}
+	static void BeginTick() {
+		Read(_begin);
+	}
 
-		if (filter.showOnlyWithErrors && !ext->HasErrors()) {
-			return false;
+	static void EndTick() {
+		std::array<uint64_t, Count> end{};
+		if (!Read(end)) {
+			return;
 		}
-
-		if (filter.states.has_value()) {
-			auto state = ext->GetState();
-			if (std::find(filter.states->begin(), filter.states->end(), state)
-			    == filter.states->end()) {
-				return false;
-			}
+		for (size_t i = 0; i < Count; ++i) {
+			auto delta = end[i] > _begin[i] ? end[i] - _begin[i] : 0;
+			_current.values[i] += delta;
+			_total.values[i] += delta;
 		}
+		++_current.ticks;
+		++_total.ticks;
 
-		if (filter.languages.has_value()) {
-			const auto& lang = ext->GetLanguage();
-			if (std::find(filter.languages->begin(), filter.languages->end(), lang)
-			    == filter.languages->end()) {
-				return false;
-			}
+		auto now = std::chrono::steady_clock::now();
+		auto elapsed = now - _windowStart;
+		if (elapsed >= std::chrono::seconds(1)) {
+			_current.elapsed = elapsed;
+			_total.elapsed += elapsed;
+			_last = _current;
+			_current = {};
+			_windowStart = now;
 		}
+	}
 
-		if (filter.searchQuery.has_value()) {
-			std::string query = filter.searchQuery.value();
-			std::transform(query.begin(), query.end(), query.begin(), ::tolower);
-
-			std::string name = ext->GetName();
-			std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+	// Last completed one-second window
+	static const Window& Last() {
+		return _last;
+	}
 
-			std::string desc = ext->GetDescription();
-			std::transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
+	static const Window& Total() {
+		return _total;
+	}
 
-			if (name.find(query) == std::string::npos && desc.find(query) == std::string::npos) {
-				return false;
-			}
+private:
+	// Values are scaled by enabled/running time when the kernel multiplexes the group
+	static bool Read(std::array<uint64_t, Count>& values) {
+		struct {
+			uint64_t nr;
+			uint64_t timeEnabled;
+			uint64_t timeRunning;
+			uint64_t values[Count];
+		} data{};
+
+		if (::read(_fds[_order.front()], &data, sizeof(data)) <= 0) {
+			return false;
 		}
 
+		double scale = data.timeRunning > 0
+		                   ? static_cast<double>(data.timeEnabled) / static_cast<double>(data.timeRunning)
+		                   : 1.0;
+		for (size_t i = 0; i < data.nr && i < _order.size(); ++i) {
+			values[_order[i]] = static_cast<uint64_t>(static_cast<double>(data.values[i]) * scale);
+		}
 		return true;
 	}
 
-	// Convert extension to JSON
-	glz::json_t ExtensionToJson(const Extension* ext) {
-		glz::json_t j;
-		j["id"] = UniqueId::Value{ ext->GetId() };
-		j["name"] = ext->GetName();
-		j["version"] = ext->GetVersionString();
-		j["type"] = ext->IsPlugin() ? "plugin" : "module";
-		j["state"] = plg::enum_to_string(ext->GetState());
-		j["language"] = ext->GetLanguage();
-		j["location"] = plg::as_string(ext->GetLocation());
+	inline static int _fds[Count] = { -1, -1, -1, -1 };
+	inline static std::vector<Counter> _order;
+	inline static std::array<uint64_t, Count> _begin{};
+	inline static Window _current;
+	inline static Window _last;
+	inline static Window _total;
+	inline static std::chrono::steady_clock::time_point _windowStart;
+};
+#endif
 
-		if (!ext->GetDescription().empty()) {
-			j["description"] = ext->GetDescription();
-		}
-		if (!ext->GetAuthor().empty()) {
-			j["author"] = ext->GetAuthor();
-		}
-		if (!ext->GetWebsite().empty()) {
-			j["website"] = ext->GetWebsite();
-		}
-		if (!ext->GetLicense().empty()) {
-			j["license"] = ext->GetLicense();
-		}
+class ConsoleLoggger final : public ILogger {
+public:
+	explicit ConsoleLoggger(
+	    const char* name,
+	    int flags = 0,
+	    LoggingVerbosity_t verbosity = LV_DEFAULT,
+	    Color color = UNSPECIFIED_LOGGING_COLOR
+	) {
+		m_channelID = LoggingSystem_RegisterLoggingChannel(name, nullptr, flags, verbosity, color);
+	}
 
-		// Dependencies
-		if (!ext->GetDependencies().empty()) {
-			glz::json_t::array_t dependencies;
-			for (const auto& dep : ext->GetDependencies()) {
-				glz::json_t::object_t depJson;
-				depJson["name"] = dep.GetName();
-				depJson["constraints"] = dep.GetConstraints().to_string();
-				depJson["optional"] = dep.IsOptional();
-				dependencies.emplace_back(std::move(depJson));
-			}
-			j["dependencies"] = glz::json_t::array_t{ std::move(dependencies) };
+	~ConsoleLoggger() override = default;
+
+	void Log(std::string_view message, Color color, bool newLine) const {
+		assert((*message.end()) == 0);
+		assert(message.size() < 2048);
+		RuntimeTrace::Instant("Print", "logging", static_cast<int64_t>(message.size()));
+		std::scoped_lock<std::mutex> lock(m_mutex);
+		LoggingSystem_Log(m_channelID, LS_MESSAGE, color, message.data());
+		if (newLine && message.back() != '\n') {
+			LoggingSystem_Log(m_channelID, LS_MESSAGE, color, "\n");
 		}
+	}
 
-		// Performance
-		j["performance"]["total_time_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
-		                                        ext->GetTotalTime()
-		)
-		                                        .count();
+	// ReSharper disable once CppPassValueParameterByConstReference
+	void Log(std::string message, bool newLine) const {
+		RuntimeTraceScope trace("Print", "logging", static_cast<int64_t>(message.size()));
+		auto tokens = AnsiColorParser::Tokenize(message);
 
-		// Errors and warnings
-		if (ext->HasErrors()) {
-			glz::json_t::array_t errors;
-			errors.reserve(ext->GetErrors().size());
-			for (const auto& error : ext->GetErrors()) {
-				errors.emplace_back(error);
+		std::scoped_lock<std::mutex> lock(m_mutex);
+		for (const auto& [text, code] : tokens) {
+			for (auto segments = SplitConsoleChunks(text); const auto& segment : segments) {
+				LoggingSystem_Log(m_channelID, LS_MESSAGE, kColorMap[code], segment.data());
 			}
-			j["errors"] = glz::json_t::array_t{ std::move(errors) };
 		}
-		if (ext->HasWarnings()) {
-			glz::json_t::array_t warnings;
-			warnings.reserve(ext->GetWarnings().size());
-			for (const auto& warning : ext->GetWarnings()) {
-				warnings.emplace_back(warning);
-			}
-			j["warnings"] = glz::json_t::array_t{ std::move(warnings) };
+		if (newLine && message.back() != '\n') {
+			LoggingSystem_Log(m_channelID, LS_MESSAGE, "\n");
 		}
-
-		return j;
 	}
 
-	// Filter extensions based on criteria
-	std::vector<const Extension*>
-	FilterExtensions(const std::vector<const Extension*>& extensions, const FilterOptions& filter) {
-		std::vector<const Extension*> result;
+	void Log(std::string_view message, Severity severity, [[maybe_unused]] std::source_location loc) override {
+		FlightRecorder::CountSeverity(static_cast<int>(severity));
+		if (severity == Severity::Fatal || severity == Severity::Error) {
+			FlightRecorder::Record(FlightRecorder::EventType::Log, static_cast<uint16_t>(severity), 0, 0, message);
+		}
 
-		for (const auto& ext : extensions) {
-			if (!MatchesFilter(ext, filter)) {
-				continue;
+		if (severity <= m_severity) {
+			RuntimeTraceScope trace("Log", "logging", static_cast<int64_t>(severity));
+			auto output = FormatLogMessage(message, severity, loc);
+
+			std::scoped_lock<std::mutex> lock(m_mutex);
+			for (auto segments = SplitConsoleChunks(output); const auto& segment : segments) {
+				switch (severity) {
+					case Severity::Unknown:
+						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::WHITE, segment.data());
+						break;
+					case Severity::Fatal:
+						LoggingSystem_Log(m_channelID, LS_ERROR, S2Colors::MAGENTA, segment.data());
+						break;
+					case Severity::Error:
+						LoggingSystem_Log(m_channelID, LS_WARNING, S2Colors::RED, segment.data());
+						break;
+					case Severity::Warning:
+						LoggingSystem_Log(m_channelID, LS_WARNING, S2Colors::ORANGE, segment.data());
+						break;
+					case Severity::Info:
+						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::YELLOW, segment.data());
+						break;
+					case Severity::Debug:
+						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::GREEN, segment.data());
+						break;
+					case Severity::Verbose:
+						LoggingSystem_Log(m_channelID, LS_MESSAGE, S2Colors::WHITE, segment.data());
+						break;
+					default:
+						break;
+				}
 			}
-			result.push_back(ext);
 		}
-
-		return result;
 	}
 
-	// Sort extensions
-	void SortExtensions(std::vector<const Extension*>& extensions, SortBy sortBy, bool reverse = false) {
-		std::sort(
-		    extensions.begin(),
-		    extensions.end(),
-		    [sortBy, reverse](const Extension* a, const Extension* b) {
-			    bool result = false;
-			    switch (sortBy) {
-				    case SortBy::Name:
-					    result = a->GetName() < b->GetName();
-					    break;
-				    case SortBy::Version:
-					    result = a->GetVersion() < b->GetVersion();
-					    break;
-				    case SortBy::State:
-					    result = a->GetState() < b->GetState();
-					    break;
-				    case SortBy::Language:
-					    result = a->GetLanguage() < b->GetLanguage();
-					    break;
-				    case SortBy::LoadTime:
-					    result = a->GetOperationTime(ExtensionState::Loaded)
-					             < b->GetOperationTime(ExtensionState::Loaded);
-					    break;
-			    }
-			    return reverse ? !result : result;
-		    }
-		);
+	void SetLogLevel(Severity minSeverity) override {
+		m_severity = minSeverity;
 	}
 
-	// Print dependency tree
-	void PrintDependencyTree(
-	    const Extension* ext,
-	    const Manager& manager,
-	    const std::string& prefix = "",
-	    bool isLast = true
-	) {
-		// Print current extension
-		std::string connector = isLast ? "└─ " : "├─ ";
-		auto [symbol, color] = GetStateInfo(ext->GetState());
+	void Flush() override {
+	}
 
-		plg::print(
-		    "{}{}{} {} {} {}",
-		    prefix,
-		    connector,
-		    Colorize(symbol, color),
-		    Colorize(ext->GetName(), Colors::ORANGE),
-		    Colorize(ext->GetVersionString(), Colors::GRAY),
-		    ext->HasErrors() ? Colorize("[ERROR]", Colors::RED) : ""
-		);
+private:
+	// Engine colors indexed by the Colors codes produced by AnsiColorParser
+	inline static const Color kColorMap[256] = {
+		S2Colors::WHITE,    // 0  0x00 (unused)
+		S2Colors::WHITE,    // 1  0x01 RESET
+		S2Colors::RED,      // 2  0x02
+		S2Colors::GREEN,    // 3  0x03
+		S2Colors::YELLOW,   // 4  0x04
+		S2Colors::BLUE,     // 5  0x05
+		S2Colors::MAGENTA,  // 6  0x06
+		S2Colors::ORANGE,   // 7  0x07
+		S2Colors::CYAN,     // 8  0x08
+		S2Colors::WHITE,    // 9  0x09 (skip - TAB)
+		S2Colors::WHITE,    // 10 0x0A (skip - LF)
+		S2Colors::GRAY,     // 11 0x0B
+		S2Colors::BLACK,    // 12 0x0C
+		S2Colors::WHITE,    // 13 0x0D (skip - CR)
+		// ... etc
+	};
 
-		// Print dependencies
-		const auto& deps = ext->GetDependencies();
-		std::string newPrefix = prefix + (isLast ? "    " : "│   ");
+	mutable std::mutex m_mutex;
+	std::atomic<Severity> m_severity{ Severity::Unknown };
+	LoggingChannelID_t m_channelID;
+};
 
-		for (size_t i = 0; i < deps.size(); ++i) {
-			const auto& dep = deps[i];
-			bool lastDep = (i == deps.size() - 1);
+// Logger for the context prepared on a background thread while Source2Main is still booting.
+// Nothing may reach LoggingSystem_Log from there before the file listener is registered, so
+// messages are held until Replay() hands them to the console logger on the game thread; from
+// then on they pass straight through.
+class DeferredLogger final : public ILogger {
+public:
+	explicit DeferredLogger(std::shared_ptr<ConsoleLoggger> target)
+	    : _target(std::move(target)) {
+	}
 
-			// Try to find the actual dependency
-			if (auto depExt = manager.FindExtension(dep.GetName())) {
-				PrintDependencyTree(depExt, manager, newPrefix, lastDep);
-			} else {
-				std::string depConnector = lastDep ? "└─ " : "├─ ";
-				std::string status = dep.IsOptional() ? "[optional]" : "[required]";
-				plg::print(
-				    "{}{}{} {} {} {} {}",
-				    newPrefix,
-				    depConnector,
-				    Icons.Skipped,
-				    dep.GetName(),
-				    dep.GetConstraints().to_string(),
-				    Colorize(status, Colors::GRAY),
-				    Colorize("[NOT FOUND]", Colors::YELLOW)
-				);
+	void Log(std::string_view message, Severity severity, std::source_location loc) override {
+		{
+			std::scoped_lock lock(_mutex);
+			if (!_replayed) {
+				_entries.emplace_back(std::string(message), severity, loc);
+				return;
 			}
 		}
+		_target->Log(message, severity, loc);
 	}
 
-	std::string GetVersionString() {
-		constexpr auto year = std::string_view(__DATE__).substr(7, 4);
-		return std::format(
-			""
-			R"(      ____)" "\n"
-			R"( ____|    \         Plugify {})" "\n"
-			R"((____|     `._____  Copyright (C) 2023-{} Untrusted Modders Team)" "\n"
-			R"( ____|       _|___)" "\n"
-			R"((____|     .'       This program may be freely redistributed under)" "\n"
-			R"(     |____/         the terms of the MIT License.)",
-			s_plugify->GetVersion(),
-			year
-		);
+	void SetLogLevel(Severity minSeverity) override {
+		_target->SetLogLevel(minSeverity);
 	}
 
-	struct HealthReport {
-		size_t score = 100;  // 0-100
-		std::vector<std::string> issues;
-		std::vector<std::string> warnings;
-		std::flat_map<std::string, size_t> statistics;
-	};
-
-	HealthReport CalculateSystemHealth(const Manager& manager) {
-		HealthReport report;
+	void Flush() override {
+		_target->Flush();
+	}
 
-		auto allExtensions = manager.GetExtensions();
-		report.statistics["total_extensions"] = allExtensions.size();
+	// plg::print output captured on the preparing thread, replayed ahead of the log entries
+	void Hold(std::string printed) {
+		std::scoped_lock lock(_mutex);
+		_printed.append(printed);
+	}
 
-		size_t failedCount = 0;
-		size_t errorCount = 0;
-		size_t warningCount = 0;
-		size_t slowLoadCount = 0;
+	// Game thread, once logging is set up
+	void Replay() {
+		std::string printed;
+		std::vector<Entry> entries;
+		{
+			std::scoped_lock lock(_mutex);
+			printed.swap(_printed);
+			entries.swap(_entries);
+			_replayed = true;
+		}
+		if (!printed.empty()) {
+			_target->Log(std::move(printed), false);
+		}
+		for (const auto& [message, severity, loc] : entries) {
+			_target->Log(message, severity, loc);
+		}
+	}
 
-		for (const auto& ext : allExtensions) {
-			if (ext->GetState() == ExtensionState::Failed
-			    || ext->GetState() == ExtensionState::Corrupted) {
-				++failedCount;
-				report.issues.push_back(std::format("{} is in failed state", ext->GetName()));
-			}
+private:
+	struct Entry {
+		std::string message;
+		Severity severity;
+		std::source_location loc;
+	};
 
-			errorCount += ext->GetErrors().size();
-			warningCount += ext->GetWarnings().size();
+	std::shared_ptr<ConsoleLoggger> _target;
+	std::mutex _mutex;
+	std::string _printed;
+	std::vector<Entry> _entries;
+	bool _replayed = false;
+};
 
-			// Check for slow loading (> 1 second)
-			auto loadTime = ext->GetOperationTime(ExtensionState::Loaded);
-			if (std::chrono::duration_cast<std::chrono::milliseconds>(loadTime).count() > 1000) {
-				++slowLoadCount;
-				report.warnings.push_back(
-				    std::format("{} took {} to load", ext->GetName(), FormatDuration(loadTime))
-				);
-			}
+class FileLoggingListener final : public ILoggingListener {
+public:
+	static Result<std::unique_ptr<FileLoggingListener>>
+	Create(const fs::path& filename, bool async = true) {
+		auto writer = LogFileWriter::Create(filename, async);
+		if (!writer) {
+			return MakeError(std::move(writer.error()));
 		}
+		return std::make_unique<FileLoggingListener>(std::move(*writer));
+	}
 
-		report.statistics["failed_extensions"] = failedCount;
-		report.statistics["extensions_with_errors"] = errorCount;
-		report.statistics["total_warnings"] = warningCount;
-		report.statistics["slow_loading_extensions"] = slowLoadCount;
+	explicit FileLoggingListener(std::unique_ptr<LogFileWriter> writer)
+	    : _writer(std::move(writer)) {
+	}
 
-		// Calculate score
-		if (failedCount > 0) {
-			report.score -= failedCount * 15;
-		}
-		if (errorCount > 0) {
-			report.score -= errorCount * 10;
-		}
-		if (warningCount > 0) {
-			report.score -= std::min<size_t>(warningCount * 2, 20);
-		}
-		if (slowLoadCount > 0) {
-			report.score -= std::min<size_t>(slowLoadCount * 5, 15);
+	void Log(const LoggingContext_t* pContext, const tchar* pMessage) override {
+		if (pContext && (pContext->m_Flags & LCF_CONSOLE_ONLY) == 0) {
+			_writer->Append(pMessage);
 		}
+	}
 
-		report.score = std::max<size_t>(0, report.score);
+private:
+	std::unique_ptr<LogFileWriter> _writer;
+};
 
-		return report;
+// Chrome trace-event recorder for the launcher startup path (--plugify-trace-startup).
+// Disabled scopes cost a relaxed load; the file is written once startup is complete.
+class StartupTrace {
+public:
+	struct Event {
+		std::string name;
+		char phase;
+		std::chrono::microseconds ts;
+		std::chrono::microseconds dur;
+		uint32_t tid;
+	};
+
+	static void Enable() {
+		_origin = std::chrono::steady_clock::now();
+		_enabled.store(true, std::memory_order_release);
+	}
+
+	static bool IsEnabled() {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	static std::chrono::microseconds Now() {
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+		    std::chrono::steady_clock::now() - _origin
+		);
+	}
+
+	static uint32_t ThreadId() {
+		thread_local uint32_t id = _nextTid.fetch_add(1, std::memory_order_relaxed);
+		return id;
+	}
+
+	static void Begin(std::string_view name) {
+		Record({ std::string(name), 'B', Now(), {}, ThreadId() });
+	}
+
+	static void End(std::string_view name) {
+		Record({ std::string(name), 'E', Now(), {}, ThreadId() });
+	}
+
+	static void Complete(
+	    std::string name,
+	    uint32_t tid,
+	    std::chrono::microseconds ts,
+	    std::chrono::microseconds dur
+	) {
+		Record({ std::move(name), 'X', ts, dur, tid });
+	}
+
+	static void NameThread(uint32_t tid, std::string name) {
+		Record({ std::move(name), 'M', {}, {}, tid });
 	}
 
-	// Helper function to parse comma-separated values
-	std::vector<std::string> ParseCsv(const std::string& str) {
-		std::vector<std::string> result;
-		std::stringstream ss(str);
-		std::string item;
-		while (std::getline(ss, item, ',')) {
-			// Trim whitespace
-			item.erase(0, item.find_first_not_of(" \t"));
-			item.erase(item.find_last_not_of(" \t") + 1);
-			if (!item.empty()) {
-				result.push_back(item);
+	// Stops recording and writes everything captured so far, open scopes stay unterminated
+	static Result<size_t> Write(const fs::path& path) {
+		_enabled.store(false, std::memory_order_release);
+
+		std::vector<Event> events;
+		{
+			std::scoped_lock lock(_mutex);
+			events = std::move(_events);
+		}
+
+		glz::json_t::array_t traceEvents;
+		traceEvents.reserve(events.size());
+		for (const auto& event : events) {
+			glz::json_t j;
+			j["pid"] = 1;
+			j["tid"] = event.tid;
+			if (event.phase == 'M') {
+				j["ph"] = "M";
+				j["name"] = "thread_name";
+				j["args"]["name"] = event.name;
+			} else {
+				j["ph"] = std::string(1, event.phase);
+				j["name"] = event.name;
+				j["cat"] = "startup";
+				j["ts"] = event.ts.count();
+				if (event.phase == 'X') {
+					j["dur"] = event.dur.count();
+				}
 			}
+			traceEvents.emplace_back(std::move(j));
 		}
-		return result;
-	};
 
-	// Helper to parse sort option
-	SortBy ParseSortBy(std::string_view str) {
-		if (str == "name") {
-			return SortBy::Name;
-		}
-		if (str == "version") {
-			return SortBy::Version;
-		}
-		if (str == "state") {
-			return SortBy::State;
-		}
-		if (str == "language") {
-			return SortBy::Language;
-		}
-		if (str == "loadtime") {
-			return SortBy::LoadTime;
+		glz::json_t trace;
+		trace["traceEvents"] = std::move(traceEvents);
+		trace["displayTimeUnit"] = "ms";
+
+		auto text = trace.dump();
+		if (!text) {
+			return MakeError("Failed to serialize startup trace");
 		}
-		return SortBy::Name;
-	};
 
-	// Helper to parse state filter
-	std::vector<ExtensionState> ParseStates(const std::vector<std::string>& strs) {
-		std::vector<ExtensionState> states;
-		states.reserve(strs.size());
-		for (const auto& str : strs) {
-			std::string lower = str;
-			std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-
-			if (lower == "loaded") {
-				states.push_back(ExtensionState::Loaded);
-			} else if (lower == "started") {
-				states.push_back(ExtensionState::Started);
-			} else if (lower == "failed") {
-				states.push_back(ExtensionState::Failed);
-			} else if (lower == "disabled") {
-				states.push_back(ExtensionState::Disabled);
-			} else if (lower == "corrupted") {
-				states.push_back(ExtensionState::Corrupted);
-			} else if (lower == "unresolved") {
-				states.push_back(ExtensionState::Unresolved);
-			}
-			// Add more as needed
-		}
-		return states;
-	};
+		std::error_code ec;
+		fs::create_directories(path.parent_path(), ec);
 
-	bool CheckManager() {
-		if (!s_plugify->IsInitialized()) {
-			plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
-			return false;
-		}
-		const auto& manager = s_plugify->GetManager();
-		if (!manager.IsInitialized()) {
-			plg::print(
-			    "{}: You must load plugin manager before query any information from it.",
-			    Colorize("Error", Colors::RED)
+		errno = 0;
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			return MakeError(
+			    "Failed to open trace file: {} - {}",
+			    plg::as_string(path),
+			    std::strerror(errno)
 			);
-			return false;
 		}
-		return true;
+		file.write(text->data(), static_cast<std::streamsize>(text->size()));
+		return events.size();
 	}
 
-	void LoadManager() {
-		if (!s_plugify->IsInitialized()) {
-			plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
+private:
+	static void Record(Event&& event) {
+		if (!IsEnabled()) {
 			return;
 		}
-		const auto& manager = s_plugify->GetManager();
-		if (manager.IsInitialized()) {
-			plg::print("{}: Plugin manager already loaded.", Colorize("Error", Colors::RED));
-		} else {
-			s_state = PlugifyState::Load;
+		std::scoped_lock lock(_mutex);
+		_events.emplace_back(std::move(event));
+	}
+
+	inline static std::atomic<bool> _enabled{ false };
+	inline static std::atomic<uint32_t> _nextTid{ 1 };
+	inline static std::chrono::steady_clock::time_point _origin;
+	inline static std::mutex _mutex;
+	inline static std::vector<Event> _events;
+};
+
+class TraceScope {
+public:
+	explicit TraceScope(std::string_view name) : _name(name) {
+		if (StartupTrace::IsEnabled()) {
+			StartupTrace::Begin(_name);
 		}
 	}
 
-	void UnloadManager() {
-		if (!s_plugify->IsInitialized()) {
-			plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
-			return;
+	~TraceScope() {
+		if (StartupTrace::IsEnabled()) {
+			StartupTrace::End(_name);
 		}
-		const auto& manager = s_plugify->GetManager();
-		if (!manager.IsInitialized()) {
-			plg::print("{}: Plugin manager already unloaded.", Colorize("Error", Colors::RED));
-		} else {
-			s_state = PlugifyState::Unload;
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	std::string_view _name;
+};
+
+enum class PlugifyCommandType { Load, Unload, Reload, ReloadOne, Swap };
+enum class PlugifyCommandStatus { Succeeded, Failed, Skipped };
+
+struct PlugifyCommand {
+	std::atomic<PlugifyCommand*> next{ nullptr };
+	uint64_t id{};
+	PlugifyCommandType type{};
+	std::string argument;
+	std::chrono::steady_clock::time_point enqueued;
+};
+
+struct PlugifyCommandResult {
+	uint64_t id{};
+	PlugifyCommandType type{};
+	std::string argument;
+	PlugifyCommandStatus status{};
+	std::string message;
+	std::chrono::microseconds queued{};
+	std::chrono::microseconds elapsed{};
+};
+
+// Intrusive multi-producer single-consumer queue (Vyukov).
+// Push is wait-free (one atomic exchange) and may be called from any thread,
+// Pop must only be called from the game thread.
+class PlugifyCommandQueue {
+public:
+	PlugifyCommandQueue() : _head(&_stub), _tail(&_stub) {}
+
+	~PlugifyCommandQueue() {
+		while (Pop()) {
 		}
 	}
 
-	void ReloadManager() {
-		if (!s_plugify->IsInitialized()) {
-			plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
-			return;
+	PlugifyCommandQueue(const PlugifyCommandQueue&) = delete;
+	PlugifyCommandQueue& operator=(const PlugifyCommandQueue&) = delete;
+
+	uint64_t Push(PlugifyCommandType type, std::string argument = {}) {
+		auto* command = new PlugifyCommand;
+		command->id = _nextId.fetch_add(1, std::memory_order_relaxed);
+		command->type = type;
+		command->argument = std::move(argument);
+		command->enqueued = std::chrono::steady_clock::now();
+		auto id = command->id;
+		_pending.fetch_add(1, std::memory_order_relaxed);
+		Link(command);
+		return id;
+	}
+
+	std::unique_ptr<PlugifyCommand> Pop() {
+		PlugifyCommand* tail = _tail;
+		PlugifyCommand* next = tail->next.load(std::memory_order_acquire);
+		if (tail == &_stub) {
+			if (!next) {
+				return nullptr;
+			}
+			_tail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next) {
+			_tail = next;
+			return Take(tail);
+		}
+		if (tail != _head.load(std::memory_order_acquire)) {
+			// A producer is between exchange and link, retry on next tick
+			return nullptr;
+		}
+		Link(&_stub);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next) {
+			_tail = next;
+			return Take(tail);
+		}
+		return nullptr;
+	}
+
+	size_t Pending() const {
+		return _pending.load(std::memory_order_relaxed);
+	}
+
+private:
+	void Link(PlugifyCommand* command) {
+		command->next.store(nullptr, std::memory_order_relaxed);
+		auto* prev = _head.exchange(command, std::memory_order_acq_rel);
+		prev->next.store(command, std::memory_order_release);
+	}
+
+	std::unique_ptr<PlugifyCommand> Take(PlugifyCommand* command) {
+		_pending.fetch_sub(1, std::memory_order_relaxed);
+		return std::unique_ptr<PlugifyCommand>(command);
+	}
+
+	alignas(64) std::atomic<PlugifyCommand*> _head;
+	alignas(64) PlugifyCommand* _tail;
+	std::atomic<uint64_t> _nextId{ 1 };
+	std::atomic<size_t> _pending{ 0 };
+	PlugifyCommand _stub;
+};
+
+// Small work-stealing pool owned by the launcher. Console commands hand expensive work to it
+// and post results back with PostMain(). ServerGamePostSimulate drains those continuations
+// under a time budget, so printing and manager access stay on the game thread.
+class TaskPool {
+public:
+	using Task = std::move_only_function<void()>;
+
+	struct Options {
+		uint32_t threads = 0;                      // 0 picks from the hardware concurrency
+		std::vector<uint32_t> affinity;            // CPUs handed to workers round-robin
+		std::chrono::microseconds budget{ 1000 };  // per tick, for main-thread continuations
+	};
+
+	struct Stats {
+		size_t workers = 0;
+		size_t queued = 0;
+		size_t continuations = 0;
+		uint64_t executed = 0;
+		uint64_t stolen = 0;
+		uint64_t drained = 0;
+	};
+
+	static void Start(const Options& options) {
+		Stop();
+		_options = options;
+
+		uint32_t threads = options.threads;
+		if (threads == 0) {
+			threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+		}
+
+		_workers.reserve(threads);
+		for (uint32_t i = 0; i < threads; ++i) {
+			_workers.emplace_back(std::make_unique<Worker>());
+		}
+		for (uint32_t i = 0; i < threads; ++i) {
+			auto& thread = _workers[i]->thread;
+			thread = std::jthread(&TaskPool::WorkerLoop, i);
+#if S2_PLATFORM_LINUX
+			auto name = std::format("plugify-task{}", i);
+			pthread_setname_np(thread.native_handle(), name.c_str());
+#endif
+			if (!options.affinity.empty()) {
+				Pin(thread, options.affinity[i % options.affinity.size()]);
+			}
+		}
+	}
+
+	// Drops queued work; tasks already running are joined
+	static void Stop() {
+		for (auto& worker : _workers) {
+			worker->thread.request_stop();
+		}
+		_idle.notify_all();
+		for (auto& worker : _workers) {
+			if (worker->thread.joinable()) {
+				worker->thread.join();
+			}
+		}
+		_workers.clear();
+		_pending.store(0, std::memory_order_relaxed);
+
+		std::scoped_lock lock(_mainMutex);
+		_main.clear();
+		_mainSize.store(0, std::memory_order_relaxed);
+	}
+
+	static bool IsRunning() {
+		return !_workers.empty();
+	}
+
+	static const Options& GetOptions() {
+		return _options;
+	}
+
+	// Safe from any thread. Runs inline when the pool is not started.
+	static void Submit(Task task) {
+		if (_workers.empty()) {
+			task();
+			return;
+		}
+
+		// Workers push to their own deque, everyone else spreads round-robin
+		size_t index = _self < _workers.size() ? _self : _next.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+		{
+			std::scoped_lock lock(_idleMutex);
+			_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+		{
+			auto& worker = *_workers[index];
+			std::scoped_lock lock(worker.mutex);
+			worker.tasks.emplace_back(std::move(task));
+		}
+		_idle.notify_one();
+	}
+
+	// Queue a continuation for the game thread
+	static void PostMain(Task task) {
+		std::scoped_lock lock(_mainMutex);
+		_main.emplace_back(std::move(task));
+		_mainSize.fetch_add(1, std::memory_order_release);
+	}
+
+	// Run work on the pool and hand its result to then() on the game thread
+	template <typename Work, typename Then>
+	static void Run(Work&& work, Then&& then) {
+		Submit([work = std::forward<Work>(work), then = std::forward<Then>(then)]() mutable {
+			PostMain([result = work(), then = std::move(then)]() mutable { then(std::move(result)); });
+		});
+	}
+
+	// Game thread only. Always runs at least one continuation so a slow one cannot starve the rest.
+	static size_t DrainMain() {
+		if (_mainSize.load(std::memory_order_acquire) == 0) {
+			return 0;
+		}
+
+		auto deadline = std::chrono::steady_clock::now() + _options.budget;
+		size_t ran = 0;
+		do {
+			Task task;
+			{
+				std::scoped_lock lock(_mainMutex);
+				if (_main.empty()) {
+					break;
+				}
+				task = std::move(_main.front());
+				_main.pop_front();
+				_mainSize.fetch_sub(1, std::memory_order_relaxed);
+			}
+			task();
+			++ran;
+		} while (std::chrono::steady_clock::now() < deadline);
+
+		_drained += ran;
+		return ran;
+	}
+
+	static Stats GetStats() {
+		Stats stats;
+		stats.workers = _workers.size();
+		stats.queued = _pending.load(std::memory_order_relaxed);
+		stats.continuations = _mainSize.load(std::memory_order_relaxed);
+		stats.drained = _drained;
+		for (const auto& worker : _workers) {
+			stats.executed += worker->executed.load(std::memory_order_relaxed);
+			stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+		}
+		return stats;
+	}
+
+private:
+	struct Worker {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+		std::atomic<uint64_t> executed{ 0 };
+		std::atomic<uint64_t> stolen{ 0 };
+		std::jthread thread;
+	};
+
+	static void WorkerLoop(std::stop_token token, size_t index) {
+		_self = index;
+		auto& worker = *_workers[index];
+
+		while (!token.stop_requested()) {
+			Task task;
+			if (TryPop(worker, task) || TrySteal(index, task)) {
+				_pending.fetch_sub(1, std::memory_order_relaxed);
+				task();
+				worker.executed.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+
+			std::unique_lock lock(_idleMutex);
+			_idle.wait(lock, token, [] { return _pending.load(std::memory_order_relaxed) > 0; });
+		}
+	}
+
+	// Owner takes the newest task, which is the most likely to be cache hot
+	static bool TryPop(Worker& worker, Task& out) {
+		std::scoped_lock lock(worker.mutex);
+		if (worker.tasks.empty()) {
+			return false;
+		}
+		out = std::move(worker.tasks.back());
+		worker.tasks.pop_back();
+		return true;
+	}
+
+	// Thieves take the oldest task from the other workers
+	static bool TrySteal(size_t index, Task& out) {
+		for (size_t i = 1; i < _workers.size(); ++i) {
+			auto& victim = *_workers[(index + i) % _workers.size()];
+			std::unique_lock lock(victim.mutex, std::try_to_lock);
+			if (!lock || victim.tasks.empty()) {
+				continue;
+			}
+			out = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			_workers[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	static void Pin(std::jthread& thread, uint32_t cpu) {
+#if S2_PLATFORM_WINDOWS
+		if (cpu < 64) {
+			SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{ 1 } << cpu);
+		}
+#elif S2_PLATFORM_LINUX
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+		(void) thread;
+		(void) cpu;
+#endif
+	}
+
+	inline static std::vector<std::unique_ptr<Worker>> _workers;
+	inline static std::atomic<size_t> _next{ 0 };
+	inline static std::atomic<size_t> _pending{ 0 };
+	inline static std::mutex _idleMutex;
+	inline static std::condition_variable_any _idle;
+	inline static std::mutex _mainMutex;
+	inline static std::deque<Task> _main;
+	inline static std::atomic<size_t> _mainSize{ 0 };
+	inline static uint64_t _drained = 0;  // game thread only
+	inline static Options _options;
+	inline static thread_local size_t _self = SIZE_MAX;
+};
+
+std::shared_ptr<Plugify> s_plugify;
+std::shared_ptr<ConsoleLoggger> s_logger;
+std::unique_ptr<FileLoggingListener> s_listener;
+PlugifyCommandQueue s_commands;
+std::deque<PlugifyCommandResult> s_commandHistory;  // game thread only
+bool s_crashpad;
+std::string s_mambaEnv;                       // environment picked with 'mamba activate'
+std::atomic<uint32_t> s_stagingJobs{ 0 };     // micromamba jobs writing to a staged environment
+
+// Prefixes that running micromamba jobs write to. MambaJobs claims one per mutating job, so two jobs
+// never write the same environment, and the game thread checks it before (re)initializing the
+// manager so plugins are never loaded from an environment that is half-installed.
+class MambaWriters {
+public:
+	// Fails with the id of the job already writing the prefix, or a parent/child of it
+	static std::optional<uint64_t> Claim(uint64_t job, const fs::path& prefix) {
+		std::scoped_lock lock(_mutex);
+		if (auto owner = FindLocked(prefix)) {
+			return owner;
+		}
+		_prefixes.emplace(job, prefix.lexically_normal());
+		return std::nullopt;
+	}
+
+	static void Release(uint64_t job) {
+		std::scoped_lock lock(_mutex);
+		_prefixes.erase(job);
+	}
+
+	// Job writing the prefix, or anything inside or above it
+	static std::optional<std::pair<uint64_t, fs::path>> Find(const fs::path& prefix) {
+		std::scoped_lock lock(_mutex);
+		if (auto owner = FindLocked(prefix)) {
+			return std::pair{ *owner, _prefixes[*owner] };
+		}
+		return std::nullopt;
+	}
+
+private:
+	static std::optional<uint64_t> FindLocked(const fs::path& prefix) {
+		auto normal = prefix.lexically_normal();
+		for (const auto& [job, claimed] : _prefixes) {
+			if (Overlaps(claimed, normal)) {
+				return job;
+			}
+		}
+		return std::nullopt;
+	}
+
+	// True when one path is the other or an ancestor of it. A trailing separator parses as an
+	// empty last element, which is skipped.
+	static bool Overlaps(const fs::path& a, const fs::path& b) {
+		auto ia = a.begin(), ib = b.begin();
+		for (; ia != a.end() && ib != b.end(); ++ia, ++ib) {
+			if (*ia != *ib) {
+				return (ia->empty() && std::next(ia) == a.end()) || (ib->empty() && std::next(ib) == b.end());
+			}
+		}
+		return true;
+	}
+
+	inline static std::mutex _mutex;
+	inline static std::map<uint64_t, fs::path> _prefixes;
+};
+
+#define BASE_PATH PLUGIFY_PATH_LITERAL("" S2_GAME_NAME "/" "addons" "/" "plugify" "/")
+#define MAMBA_PATH BASE_PATH PLUGIFY_PATH_LITERAL("bin" "/" S2_BINARY "/" S2_EXECUTABLE_PREFIX "micromamba" S2_EXECUTABLE_SUFFIX)
+
+// Redirects console output of the current thread into a buffer ('plugify -o'), so a report
+// reaches its file in one piece instead of going through the 2048-byte console chunking
+class OutputCapture {
+public:
+	explicit OutputCapture(std::string& buffer)
+	    : _previous(_target) {
+		_target = &buffer;
+	}
+
+	~OutputCapture() {
+		_target = _previous;
+	}
+
+	OutputCapture(const OutputCapture&) = delete;
+	OutputCapture& operator=(const OutputCapture&) = delete;
+
+	static bool Active() {
+		return _target != nullptr;
+	}
+
+	// Appends the message as one line, returns false when nothing is capturing
+	static bool Append(std::string_view message) {
+		if (!_target) {
+			return false;
+		}
+		_target->append(message);
+		if (message.empty() || message.back() != '\n') {
+			_target->push_back('\n');
+		}
+		return true;
+	}
+
+private:
+	inline static thread_local std::string* _target = nullptr;
+	std::string* _previous;
+};
+
+// Large reports are queued here and written from ServerGamePostSimulate a bounded amount per
+// tick, so a listing of thousands of extensions never turns into thousands of
+// LoggingSystem_Log calls inside one frame. While anything is queued every plg::print joins the
+// queue too, so later output never overtakes a listing still being paged out.
+class ConsolePager {
+public:
+	static constexpr size_t kLinesPerTick = 48;
+	static constexpr size_t kBytesPerTick = 8 * 1024;
+
+	static bool Fits(std::string_view text) {
+		return text.size() <= kBytesPerTick && CountLines(text) <= kLinesPerTick;
+	}
+
+	static bool Busy() {
+		return _busy.load(std::memory_order_acquire);
+	}
+
+	// Set while the ServerGamePostSimulate hook that drives Tick() is installed
+	static bool Attached() {
+		return _attached.load(std::memory_order_acquire);
+	}
+
+	static void Attach() {
+		_attached.store(true, std::memory_order_release);
+	}
+
+	// Writes whatever is still queued in one go, nothing would tick it out any more
+	static void Detach() {
+		_attached.store(false, std::memory_order_release);
+		std::deque<std::string> pending;
+		size_t offset;
+		{
+			std::scoped_lock lock(_mutex);
+			pending.swap(_pending);
+			offset = std::exchange(_offset, 0);
+			_busy.store(false, std::memory_order_release);
+		}
+		if (s_logger) {
+			for (auto& text : pending) {
+				s_logger->Log(std::string(std::string_view(text).substr(std::exchange(offset, 0))), false);
+			}
+		}
+	}
+
+	static void Enqueue(std::string text) {
+		if (text.empty()) {
+			return;
+		}
+		if (text.back() != '\n') {
+			text.push_back('\n');
+		}
+		std::scoped_lock lock(_mutex);
+		_pending.push_back(std::move(text));
+		_busy.store(true, std::memory_order_release);
+	}
+
+	// plg::print hook: queues the message behind pending output, returns false when nothing is
+	// pending and the message can be printed directly
+	static bool Append(std::string_view message) {
+		if (!Busy() || !Attached()) {
+			return false;
+		}
+		std::scoped_lock lock(_mutex);
+		if (_pending.empty()) {
+			return false;
+		}
+		auto& text = _pending.emplace_back(message);
+		if (text.empty() || text.back() != '\n') {
+			text.push_back('\n');
+		}
+		return true;
+	}
+
+	// Game thread. Chunks are cut under the lock and logged after it is released, so a listener
+	// that prints cannot deadlock on the queue.
+	static void Tick() {
+		if (!Busy()) {
+			return;
+		}
+
+		std::vector<std::string> chunks;
+		{
+			std::scoped_lock lock(_mutex);
+			size_t lines = 0;
+			size_t bytes = 0;
+			while (!_pending.empty() && lines < kLinesPerTick && bytes < kBytesPerTick) {
+				auto rest = std::string_view(_pending.front()).substr(_offset);
+
+				// Whole lines while both budgets last, a single oversized line is cut at the byte budget
+				size_t end = 0;
+				while (end < rest.size() && lines < kLinesPerTick) {
+					auto newline = rest.find('\n', end);
+					auto next = newline == std::string_view::npos ? rest.size() : newline + 1;
+					if (bytes + next > kBytesPerTick) {
+						if (end == 0) {
+							end = kBytesPerTick - bytes;
+							while (end > 0 && (static_cast<unsigned char>(rest[end]) & 0xC0) == 0x80) {
+								--end;
+							}
+						}
+						lines = kLinesPerTick;
+						break;
+					}
+					end = next;
+					++lines;
+				}
+				if (end == 0) {
+					break;
+				}
+
+				bytes += end;
+				chunks.emplace_back(rest.substr(0, end));
+				_offset += end;
+				if (_offset == _pending.front().size()) {
+					_pending.pop_front();
+					_offset = 0;
+				}
+			}
+			_busy.store(!_pending.empty(), std::memory_order_release);
+		}
+
+		for (auto& chunk : chunks) {
+			s_logger->Log(std::move(chunk), false);
+		}
+	}
+
+private:
+	inline static std::mutex _mutex;
+	inline static std::deque<std::string> _pending;
+	inline static size_t _offset = 0;
+	inline static std::atomic<bool> _busy{ false };
+	inline static std::atomic<bool> _attached{ false };
+};
+
+namespace plg {
+	/*PLUGIFY_FORCE_INLINE void print(const char* msg) {
+		s_logger->Log(msg, S2Colors::WHITE, false);
+	}
+
+	PLUGIFY_FORCE_INLINE void print(std::string&& msg) {
+		s_logger->Log(std::move(msg), false);
+	}
+
+	template<typename... Args>
+	PLUGIFY_FORCE_INLINE void print(std::format_string<Args...> fmt, Args&&... args) {
+		s_logger->Log(std::format(fmt, std::forward<Args>(args)...), false);
+	}*/
+
+	PLUGIFY_FORCE_INLINE void print(const char* msg) {
+		if (OutputCapture::Append(msg) || ConsolePager::Append(msg)) {
+			return;
+		}
+		s_logger->Log(msg, S2Colors::WHITE, true);
+	}
+
+	PLUGIFY_FORCE_INLINE void print(std::string&& msg) {
+		if (OutputCapture::Append(msg) || ConsolePager::Append(msg)) {
+			return;
+		}
+		s_logger->Log(std::move(msg), true);
+	}
+
+	template <typename... Args>
+	PLUGIFY_FORCE_INLINE void print(std::format_string<Args...> fmt, Args&&... args) {
+		print(std::format(fmt, std::forward<Args>(args)...));
+	}
+}
+
+namespace {
+	constexpr const char* SEPARATOR_LINE = "--------------------------------------------------------------------------------";
+	constexpr const char* DOUBLE_LINE = "================================================================================";
+
+	template <typename T>
+	Result<T> ReadJson(const fs::path& path) {
+		errno = 0;
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return MakeError(
+				"Failed to read json file: {} - {}",
+				plg::as_string(path),
+				std::strerror(errno)
+			);
+		}
+		auto text = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		auto json = glz::read_jsonc<T>(text);
+		if (!json) {
+			return MakeError(glz::format_error(json.error(), text));
+		}
+
+		return *json;
+	}
+
+	using ColorCode = char;
+
+	// Helper to apply color
+	std::string Colorize(std::string_view text, ColorCode color) {
+		return std::format("{}{}{}", color, text, Colors::RESET);
+	}
+
+	// Helper to format duration
+	std::string FormatDuration(std::chrono::microseconds duration) {
+		using namespace std::chrono;
+		auto ns = duration_cast<nanoseconds>(duration).count();
+		if (ns < 1000) {
+			return std::format("{}ns", ns);
+		} else if (ns < 1000000) {
+			return std::format("{:.2f}us", static_cast<double>(ns) / 1000.0);
+		} else if (ns < 1000000000) {
+			return std::format("{:.2f}ms", static_cast<double>(ns) / 1000000.0);
+		} else {
+			return std::format("{:.2f}s", static_cast<double>(ns) / 1000000000.0);
+		}
+	}
+
+	// Get state info with color
+
+	struct StateInfo {
+		std::string_view symbol;
+		ColorCode color;
+	};
+
+	struct Glyphs {
+		std::string_view Ok;
+		std::string_view Fail;
+		std::string_view Warning;
+		std::string_view Skipped;
+		std::string_view Valid;
+		std::string_view Resolving;
+		std::string_view Arrow;
+		std::string_view Number;
+		std::string_view Unknown;
+		std::string_view Missing;
+		std::string_view Equal;
+		std::string_view NotEqual;
+		std::string_view Running;
+	};
+
+	// Unicode (original)
+	inline constexpr Glyphs UnicodeGlyphs{
+		"✓", "✗", "⚠", "○", "●", "⋯", "→", "#", "?", "ℹ", "=", "≠", "⚙",
+	};
+
+	// Plain ASCII fallback
+	inline constexpr Glyphs AsciiGlyphs{
+		"v", "x", "!", "o", "*", "...", "->", "#", "?", "i", "=", "!=", ">>",
+	};
+
+	// selection strategy examples:
+
+	// 1) Compile-time: define USE_ASCII or USE_ASCII_ANSI in your build
+#define USE_ASCII
+#if defined(USE_ASCII)
+	inline constexpr const Glyphs& Icons = AsciiGlyphs;
+#else
+	inline constexpr const Glyphs& Icons = UnicodeGlyphs;
+#endif
+
+	StateInfo GetStateInfo(ExtensionState state) {
+		switch (state) {
+			case ExtensionState::Parsed:
+			case ExtensionState::Resolved:
+			case ExtensionState::Started:
+			case ExtensionState::Loaded:
+			case ExtensionState::Exported:
+				return { Icons.Ok, Colors::MAGENTA };
+			case ExtensionState::Failed:
+			case ExtensionState::Corrupted:
+				return { Icons.Fail, Colors::RED };
+			case ExtensionState::Unresolved:
+				return { Icons.Warning, Colors::YELLOW };
+			case ExtensionState::Disabled:
+			case ExtensionState::Skipped:
+				return { Icons.Skipped, Colors::GRAY };
+			case ExtensionState::Loading:
+			case ExtensionState::Starting:
+			case ExtensionState::Parsing:
+			case ExtensionState::Resolving:
+			case ExtensionState::Exporting:
+			case ExtensionState::Ending:
+			case ExtensionState::Terminating:
+				return { Icons.Resolving, Colors::CYAN };
+			case ExtensionState::Running:
+				return { Icons.Running, Colors::GREEN };
+			default:
+				return { Icons.Unknown, Colors::GRAY };
+		}
+	}
+
+	// Helper to truncate string
+	std::string Truncate(const std::string& str, size_t maxLen) {
+		if (str.length() <= maxLen) {
+			return str;
+		}
+		return str.substr(0, maxLen - 3) + "...";
+	}
+
+	// Format file size
+	std::uintmax_t GetSizeRecursive(const fs::path& path) {
+		namespace fs = fs;
+		std::uintmax_t totalSize = 0;
+		std::error_code ec;
+
+		if (fs::is_regular_file(path, ec)) {
+			auto sz = fs::file_size(path, ec);
+			if (!ec) {
+				totalSize += sz;
+			}
+		} else if (fs::is_directory(path)) {
+			for (auto& entry : fs::recursive_directory_iterator(
+			         path,
+			         fs::directory_options::skip_permission_denied,
+			         ec
+			     )) {
+				if (fs::is_regular_file(entry, ec)) {
+					auto sz = fs::file_size(entry, ec);
+					if (!ec) {
+						totalSize += sz;
+					}
+				}
+			}
+		}
+		return totalSize;
+	}
+
+	std::string FormatFileSize(const fs::path& path) {
+		try {
+			auto size = GetSizeRecursive(path);
+			if (size < 1024) {
+				return std::format("{} B", size);
+			} else if (size < 1024 * 1024) {
+				return std::format("{:.1f} KB", static_cast<double>(size) / 1024.0);
+			} else if (size < 1024ull * 1024 * 1024) {
+				return std::format("{:.1f} MB", static_cast<double>(size) / (1024.0 * 1024.0));
+			} else {
+				return std::format("{:.1f} GB", static_cast<double>(size) / (1024.0 * 1024.0 * 1024.0));
+			}
+		} catch (...) {
+			return "N/A";
+		}
+	}
+
+	UniqueId FormatId(std::string_view str) {
+		UniqueId::Value result;
+		auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+		if (ec != std::errc{}) {
+			plg::print("{}: {}", Colorize("Error", Colors::RED), std::make_error_code(ec).message());
+			return {};
+		} else if (ptr != str.data() + str.size()) {
+			plg::print(
+			    "{}: Invalid argument: trailing characters after the valid part",
+			    Colorize("Error", Colors::RED)
+			);
+			return {};
+		}
+		return UniqueId{ result };
+	}
+
+	fs::path FormatFileName(std::string_view type, std::string_view format) {
+		using namespace std::chrono;
+		auto now = system_clock::now();
+		auto seconds = floor<std::chrono::seconds>(now);
+		auto ms = duration_cast<milliseconds>(now - seconds);  // %F = YYYY-MM-DD, %T = HH:MM:SS
+		std::string timestamp = std::format("{:%F-%T}", seconds, static_cast<int>(ms.count()));
+		for (auto& c : timestamp) {
+			if (c == ':') {
+				c = '-';
+			}
+		}
+		return std::format("{}-{}.{}", type, timestamp, format);
+	}
+
+	// Print dependency tree
+	void PrintDependencyTree(
+	    ReportBuffer& report,
+	    const Extension* ext,
+	    const Manager& manager,
+	    const std::string& prefix = "",
+	    bool isLast = true
+	) {
+		// Print current extension
+		std::string_view connector = isLast ? "└─ " : "├─ ";
+		auto [symbol, color] = GetStateInfo(ext->GetState());
+
+		report.Append(prefix).Append(connector).Append(symbol, color).Spaces(1);
+		report.Append(ext->GetName(), Colors::ORANGE).Spaces(1);
+		report.Append(ext->GetVersionString(), Colors::GRAY);
+		if (ext->HasErrors()) {
+			report.Spaces(1).Append("[ERROR]", Colors::RED);
+		}
+		report.Line();
+
+		// Print dependencies
+		const auto& deps = ext->GetDependencies();
+		std::string newPrefix = prefix + (isLast ? "    " : "│   ");
+
+		for (size_t i = 0; i < deps.size(); ++i) {
+			const auto& dep = deps[i];
+			bool lastDep = (i == deps.size() - 1);
+
+			// Try to find the actual dependency
+			if (auto depExt = manager.FindExtension(dep.GetName())) {
+				PrintDependencyTree(report, depExt, manager, newPrefix, lastDep);
+			} else {
+				report.Append(newPrefix).Append(lastDep ? "└─ " : "├─ ").Append(Icons.Skipped).Spaces(1);
+				report.Append(dep.GetName()).Spaces(1).Append(dep.GetConstraints().to_string()).Spaces(1);
+				report.Append(dep.IsOptional() ? "[optional]" : "[required]", Colors::GRAY).Spaces(1);
+				report.Line("[NOT FOUND]", Colors::YELLOW);
+			}
+		}
+	}
+
+	std::string GetVersionString() {
+		constexpr auto year = std::string_view(__DATE__).substr(7, 4);
+		return std::format(
+			""
+			R"(      ____)" "\n"
+			R"( ____|    \         Plugify {})" "\n"
+			R"((____|     `._____  Copyright (C) 2023-{} Untrusted Modders Team)" "\n"
+			R"( ____|       _|___)" "\n"
+			R"((____|     .'       This program may be freely redistributed under)" "\n"
+			R"(     |____/         the terms of the MIT License.)",
+			s_plugify->GetVersion(),
+			year
+		);
+	}
+
+	struct HealthReport {
+		size_t score = 100;  // 0-100
+		std::vector<std::string> issues;
+		std::vector<std::string> warnings;
+		std::flat_map<std::string, size_t> statistics;
+	};
+
+	HealthReport CalculateSystemHealth(const Manager& manager) {
+		HealthReport report;
+
+		auto allExtensions = manager.GetExtensions();
+		report.statistics["total_extensions"] = allExtensions.size();
+
+		size_t failedCount = 0;
+		size_t errorCount = 0;
+		size_t warningCount = 0;
+		size_t slowLoadCount = 0;
+
+		for (const auto& ext : allExtensions) {
+			if (ext->GetState() == ExtensionState::Failed
+			    || ext->GetState() == ExtensionState::Corrupted) {
+				++failedCount;
+				report.issues.push_back(std::format("{} is in failed state", ext->GetName()));
+			}
+
+			errorCount += ext->GetErrors().size();
+			warningCount += ext->GetWarnings().size();
+
+			// Check for slow loading (> 1 second)
+			auto loadTime = ext->GetOperationTime(ExtensionState::Loaded);
+			if (std::chrono::duration_cast<std::chrono::milliseconds>(loadTime).count() > 1000) {
+				++slowLoadCount;
+				report.warnings.push_back(
+				    std::format("{} took {} to load", ext->GetName(), FormatDuration(loadTime))
+				);
+			}
+		}
+
+		report.statistics["failed_extensions"] = failedCount;
+		report.statistics["extensions_with_errors"] = errorCount;
+		report.statistics["total_warnings"] = warningCount;
+		report.statistics["slow_loading_extensions"] = slowLoadCount;
+
+		// Calculate score
+		if (failedCount > 0) {
+			report.score -= failedCount * 15;
+		}
+		if (errorCount > 0) {
+			report.score -= errorCount * 10;
+		}
+		if (warningCount > 0) {
+			report.score -= std::min<size_t>(warningCount * 2, 20);
+		}
+		if (slowLoadCount > 0) {
+			report.score -= std::min<size_t>(slowLoadCount * 5, 15);
+		}
+
+		report.score = std::max<size_t>(0, report.score);
+
+		return report;
+	}
+	// Detects game thread stalls by timing each ServerGamePostSimulate from its start.
+	// Detects game thread stalls from a heartbeat bumped every tick.
+	// When a tick runs longer than the stall threshold it logs an alert, attributes the stall
+	// to an extension from a stack snapshot of the game thread (Linux), and writes a non-fatal
+	// minidump when Crashpad is running. Past the abort threshold the process exits so the
+	// orchestrator can restart it.
+	class Watchdog {
+	public:
+		struct Options {
+			std::chrono::milliseconds stall{ 0 };  // 0 disables the watchdog
+			std::chrono::milliseconds abort{ 0 };  // 0 never terminates
+			bool dump = true;
+		};
+
+		// Brackets ServerGamePostSimulate. Only time spent inside a tick counts, so a map change or
+		// a hibernating server with no ticks at all is never mistaken for a stall.
+		struct TickScope {
+			TickScope() {
+				auto now = std::chrono::steady_clock::now().time_since_epoch();
+				_tickStart.store(std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(), 1), std::memory_order_release);
+			}
+
+			~TickScope() {
+				_tickStart.store(0, std::memory_order_release);
+			}
+		};
+
+		// Must be called on the game thread
+		static void Configure(const Options& options) {
+			Stop();
+			_options = options;
+			if (options.stall.count() <= 0) {
+				return;
+			}
+#if S2_PLATFORM_LINUX
+			_gameThread = pthread_self();
+			_gameStack = FrameWalk::CurrentStack();
+			struct sigaction action{};
+			action.sa_sigaction = &SnapshotHandler;
+			action.sa_flags = SA_SIGINFO | SA_RESTART;
+			sigemptyset(&action.sa_mask);
+			sigaction(SnapshotSignal(), &action, nullptr);
+#endif
+			_thread = std::jthread(&Watchdog::Run);
+			RefreshModules();
+		}
+
+		// Rebuilds the module ranges stall reports attribute frames with. Game thread only, after
+		// anything that loads or unloads extensions.
+		static void RefreshModules() {
+#if S2_PLATFORM_LINUX
+			if (!IsRunning()) {
+				return;
+			}
+			std::vector<const Extension*> extensions;
+			if (s_plugify && s_plugify->GetManager().IsInitialized()) {
+				extensions = s_plugify->GetManager().GetExtensions();
+			}
+			_modules.store(std::make_shared<const ModuleIndex>(ModuleIndex::Build(extensions)), std::memory_order_release);
+#endif
+		}
+
+		static void Stop() {
+			if (_thread.joinable()) {
+				_thread.request_stop();
+				_wake.notify_all();
+				_thread.join();
+			}
+		}
+
+		static bool IsRunning() {
+			return _thread.joinable();
+		}
+
+		static const Options& GetOptions() {
+			return _options;
+		}
+
+		static uint64_t GetStallCount() {
+			return _stalls.load(std::memory_order_relaxed);
+		}
+
+		static std::string GetLastOwner() {
+			std::scoped_lock lock(_mutex);
+			return _lastOwner;
+		}
+
+	private:
+		static void Run(std::stop_token token) {
+			using namespace std::chrono;
+
+			auto poll = std::clamp(duration_cast<milliseconds>(_options.stall / 4), milliseconds(10), milliseconds(250));
+			int64_t seen = 0;
+			bool reported = false;
+
+			while (!token.stop_requested()) {
+				{
+					std::unique_lock lock(_mutex);
+					_wake.wait_for(lock, token, poll, [] { return false; });
+				}
+				if (token.stop_requested()) {
+					break;
+				}
+
+				auto start = _tickStart.load(std::memory_order_acquire);
+				if (start == 0) {
+					// Between ticks, however long the engine takes to call the next one
+					reported = false;
+					continue;
+				}
+				if (start != seen) {
+					seen = start;
+					reported = false;
+				}
+
+				auto now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+				auto stalled = duration_cast<milliseconds>(nanoseconds(now - start));
+				if (!reported && stalled >= _options.stall) {
+					reported = true;
+					ReportStall(stalled);
+				}
+
+				if (_options.abort.count() > 0 && stalled >= _options.abort) {
+					FlightRecorder::Record(FlightRecorder::EventType::Stall, 1, 0, static_cast<uint64_t>(stalled.count()), "terminated");
+					WriteRaw("Watchdog: Game thread stalled for {}, terminating.", FormatDuration(stalled));
+					std::_Exit(EXIT_FAILURE);
+				}
+			}
+		}
+
+		static void ReportStall(std::chrono::milliseconds stalled) {
+			auto owner = SnapshotOwner();
+			{
+				std::scoped_lock lock(_mutex);
+				_lastOwner = owner;
+			}
+			_stalls.fetch_add(1, std::memory_order_relaxed);
+			FlightRecorder::Record(
+			    FlightRecorder::EventType::Stall,
+			    0,
+			    0,
+			    static_cast<uint64_t>(stalled.count()),
+			    owner
+			);
+
+			WriteRaw("Watchdog: Game thread stalled for {} inside {}", FormatDuration(stalled), owner);
+
+			if (s_crashpad && _options.dump) {
+				static crashpad::StringAnnotation<128> annotation("plugify_hung_extension");
+				annotation.Set(owner);
+				CRASHPAD_SIMULATE_CRASH();
+				WriteRaw("Watchdog: Non-fatal minidump captured.");
+			}
+		}
+
+		// Stall output bypasses plg::print: the stuck thread may hold the logger mutex or tier0's
+		// lock, so the line is formatted on the stack and handed straight to stderr
+		template <typename... Args>
+		static void WriteRaw(std::format_string<Args...> fmt, Args&&... args) {
+			char buffer[512];
+			auto result = std::format_to_n(buffer, sizeof(buffer) - 1, fmt, std::forward<Args>(args)...);
+			auto size = std::min(static_cast<size_t>(result.size), sizeof(buffer) - 1);
+			buffer[size++] = '\n';
+#if S2_PLATFORM_WINDOWS
+			DWORD written;
+			WriteFile(GetStdHandle(STD_ERROR_HANDLE), buffer, static_cast<DWORD>(size), &written, nullptr);
+#else
+			std::ignore = ::write(STDERR_FILENO, buffer, size);
+#endif
+		}
+
+#if S2_PLATFORM_LINUX
+		static int SnapshotSignal() {
+			return SIGRTMIN + 3;
+		}
+
+		// The interrupted thread is stalled, possibly inside the loader or the unwinder, so the
+		// handler must not call into either
+		static void SnapshotHandler(int, siginfo_t*, void* context) {
+			int savedErrno = errno;
+			_snapshotDepth = FrameWalk::Walk(context, _gameStack, _snapshot, static_cast<int>(std::size(_snapshot)));
+			_snapshotReady.store(true, std::memory_order_release);
+			errno = savedErrno;
+		}
+
+		// Attributes frames with the module snapshot from the last RefreshModules; the manager is
+		// never touched here, the game thread may be stalled in the middle of mutating it
+		static std::string SnapshotOwner() {
+			_snapshotReady.store(false, std::memory_order_relaxed);
+			if (pthread_kill(_gameThread, SnapshotSignal()) != 0) {
+				return "unknown";
+			}
+			for (int i = 0; i < 100 && !_snapshotReady.load(std::memory_order_acquire); ++i) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+			if (!_snapshotReady.load(std::memory_order_acquire) || _snapshotDepth <= 0) {
+				return "unknown";
+			}
+
+			auto index = _modules.load(std::memory_order_acquire);
+			if (!index) {
+				return "unknown";
+			}
+			std::span frames(_snapshot, static_cast<size_t>(_snapshotDepth));
+			auto owner = index->Owner(frames);
+			if (owner.empty()) {
+				return frames.empty() ? "[engine]" : std::format("[engine] {}", index->Symbolize(reinterpret_cast<uintptr_t>(frames.front())));
+			}
+			return std::string(owner);
+		}
+
+		inline static pthread_t _gameThread{};
+		inline static FrameWalk::Stack _gameStack;
+		inline static void* _snapshot[32];
+		inline static int _snapshotDepth = 0;
+		inline static std::atomic<bool> _snapshotReady{ false };
+		inline static std::atomic<std::shared_ptr<const ModuleIndex>> _modules;
+#else
+		static std::string SnapshotOwner() {
+			return "unknown";
+		}
+#endif
+
+		inline static std::atomic<int64_t> _tickStart{ 0 };  // steady ns, 0 outside a tick
+		inline static std::atomic<uint64_t> _stalls{ 0 };
+		inline static Options _options;
+		inline static std::jthread _thread;
+		inline static std::mutex _mutex;
+		inline static std::condition_variable_any _wake;
+		inline static std::string _lastOwner;
+	};
+
+	void ConfigureWatchdog(std::optional<int> stallMs, std::optional<int> abortMs, bool noDump, bool disable) {
+		auto options = Watchdog::GetOptions();
+		bool changed = false;
+		if (disable) {
+			options.stall = {};
+			changed = true;
+		}
+		if (stallMs) {
+			options.stall = std::chrono::milliseconds(*stallMs);
+			changed = true;
+		}
+		if (abortMs) {
+			options.abort = std::chrono::milliseconds(*abortMs);
+			changed = true;
+		}
+		if (noDump) {
+			options.dump = false;
+			changed = true;
+		}
+		if (changed) {
+			Watchdog::Configure(options);
+		}
+
+		const auto& current = Watchdog::GetOptions();
+		plg::print(
+		    "{}: {}",
+		    Colorize("WATCHDOG", Colors::ORANGE),
+		    Watchdog::IsRunning() ? Colorize("running", Colors::GREEN) : Colorize("disabled", Colors::GRAY)
+		);
+		plg::print(SEPARATOR_LINE);
+		plg::print("  Stall threshold:  {}", current.stall.count() > 0 ? FormatDuration(current.stall) : "off");
+		plg::print("  Abort threshold:  {}", current.abort.count() > 0 ? FormatDuration(current.abort) : "off");
+		plg::print("  Minidump:         {}", current.dump && s_crashpad ? "yes" : "no");
+		plg::print("  Stalls detected:  {}", Watchdog::GetStallCount());
+		if (auto owner = Watchdog::GetLastOwner(); !owner.empty()) {
+			plg::print("  Last stall in:    {}", Colorize(owner, Colors::ORANGE));
+		}
+		plg::print(SEPARATOR_LINE);
+	}
+
+	bool CheckManager() {
+		if (!s_plugify->IsInitialized()) {
+			plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
+			return false;
+		}
+		const auto& manager = s_plugify->GetManager();
+		if (!manager.IsInitialized()) {
+			plg::print(
+			    "{}: You must load plugin manager before query any information from it.",
+			    Colorize("Error", Colors::RED)
+			);
+			return false;
+		}
+		return true;
+	}
+
+	void QueueCommand(PlugifyCommandType type, std::string argument = {}) {
+		if (!s_plugify->IsInitialized()) {
+			plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
+			return;
+		}
+		auto id = s_commands.Push(type, std::move(argument));
+		plg::print(
+		    "{}: Command #{} ({}) queued, {} pending.",
+		    Colorize("Info", Colors::BLUE),
+		    id,
+		    plg::enum_to_string(type),
+		    s_commands.Pending()
+		);
+	}
+
+	void LoadManager() {
+		QueueCommand(PlugifyCommandType::Load);
+	}
+
+	void UnloadManager() {
+		QueueCommand(PlugifyCommandType::Unload);
+	}
+
+	// Staged environments live next to envs/ rather than inside it, so the manager
+	// never discovers a half-installed package on a reload
+	fs::path StagingDir() {
+		return fs::path(Plat_GetGameDirectory()) / BASE_PATH / "staging";
+	}
+
+	fs::path EnvironmentDir(std::string_view env) {
+		return fs::path(Plat_GetGameDirectory()) / BASE_PATH / "envs" / env;
+	}
+
+	// Fails while a micromamba job writes 'prefix' (or an environment inside it), so the manager
+	// never loads plugins from a half-installed environment
+	Result<void> CheckEnvironmentIdle(const fs::path& prefix) {
+		if (auto writer = MambaWriters::Find(prefix)) {
+			return MakeError(
+			    "micromamba job #{} is still writing {}, wait for it or run 'mamba cancel {}'.",
+			    writer->first,
+			    plg::as_string(writer->second),
+			    writer->first
+			);
+		}
+		return {};
+	}
+
+	void SwapEnvironment(std::string_view env) {
+		QueueCommand(PlugifyCommandType::Swap, std::string(env));
+	}
+
+	// Moves the staged environment into envs/ with two renames and reloads. The previous
+	// environment is kept as staging/<env>.previous until the next swap.
+	Result<std::string> ExecuteSwap(Manager& manager, const std::string& env) {
+		if (env.empty()) {
+			return MakeError("No environment selected, run 'mamba activate <env>' or pass a name.");
+		}
+		if (s_stagingJobs.load(std::memory_order_acquire) > 0) {
+			return MakeError("A staged micromamba job is still running.");
+		}
+		if (auto idle = CheckEnvironmentIdle(EnvironmentDir(env)); !idle) {
+			return MakeError(std::move(idle.error()));
+		}
+
+		auto staged = StagingDir() / env;
+		auto live = EnvironmentDir(env);
+		auto previous = StagingDir() / (env + ".previous");
+
+		std::error_code ec;
+		if (!fs::is_directory(staged, ec)) {
+			return MakeError("No staged environment for {}, run 'mamba --stage ...' first.", env);
+		}
+
+		// The environment kept from the last swap is renamed out of the way and deleted on the pool,
+		// so only the two renames below run while plugins are down
+		if (fs::exists(previous, ec)) {
+			auto discarded = StagingDir() / std::format("{}.discarded-{}", env, std::chrono::system_clock::now().time_since_epoch().count());
+			fs::rename(previous, discarded, ec);
+			if (ec) {
+				return MakeError("Failed to move {} aside: {}", plg::as_string(previous), ec.message());
+			}
+			TaskPool::Submit([discarded = std::move(discarded)] {
+				std::error_code removeEc;
+				fs::remove_all(discarded, removeEc);
+			});
+		}
+
+		bool wasLoaded = manager.IsInitialized();
+		if (wasLoaded) {
+			manager.Terminate();
+		}
+
+		auto restart = [&]() -> Result<void> {
+			if (!wasLoaded) {
+				return {};
+			}
+			return manager.Initialize();
+		};
+
+		bool hadLive = fs::exists(live, ec);
+		if (hadLive) {
+			fs::rename(live, previous, ec);
+			if (ec) {
+				auto message = ec.message();
+				std::ignore = restart();
+				return MakeError("Failed to move {} aside: {}", plg::as_string(live), message);
+			}
+		}
+
+		fs::rename(staged, live, ec);
+		if (ec) {
+			auto message = ec.message();
+			if (hadLive) {
+				fs::rename(previous, live, ec);
+			}
+			std::ignore = restart();
+			return MakeError("Failed to activate staged environment: {}", message);
+		}
+
+		if (auto result = restart(); !result) {
+			// Put the previous environment back so the server comes up as it was
+			auto message = std::move(result.error());
+			manager.Terminate();
+			fs::rename(live, staged, ec);
+			if (hadLive) {
+				fs::rename(previous, live, ec);
+			}
+			std::ignore = restart();
+			return MakeError("Staged environment failed to load, rolled back: {}", message);
+		}
+
+		return std::format(
+		    "Environment {} swapped{}.",
+		    env,
+		    wasLoaded ? " and plugin manager reloaded" : ""
+		);
+	}
+
+	void ReloadManager(std::string_view name = {}) {
+		if (name.empty()) {
+			QueueCommand(PlugifyCommandType::Reload);
+		} else {
+			QueueCommand(PlugifyCommandType::ReloadOne, std::string(name));
+		}
+	}
+
+	// Snapshot of every extension's state around a load/unload, for post-mortem context
+	void RecordExtensions(const Manager& manager) {
+		if (!FlightRecorder::IsOpen()) {
+			return;
+		}
+		for (const auto* ext : manager.GetExtensions()) {
+			FlightRecorder::Record(
+			    FlightRecorder::EventType::Extension,
+			    static_cast<uint16_t>(ext->GetState()),
+			    0,
+			    0,
+			    ext->GetName()
+			);
+		}
+	}
+
+	// Runs on the game thread. Preconditions are checked here rather than at enqueue time
+	// so that a burst like "unload; load" is evaluated against the state each command sees.
+	PlugifyCommandResult ExecuteCommand(const PlugifyCommand& command) {
+		using namespace std::chrono;
+
+		PlugifyCommandResult result{
+			.id = command.id,
+			.type = command.type,
+			.argument = command.argument,
+			.status = PlugifyCommandStatus::Succeeded,
+		};
+
+		constexpr const char* kTraceNames[] = { "Load", "Unload", "Reload", "ReloadOne", "Swap" };
+		RuntimeTraceScope trace(
+		    kTraceNames[static_cast<size_t>(command.type)],
+		    "state",
+		    static_cast<int64_t>(command.id)
+		);
+
+		S2_PROBE2(state__begin, command.id, static_cast<int>(command.type));
+		FlightRecorder::Record(
+		    FlightRecorder::EventType::State,
+		    static_cast<uint16_t>(command.type),
+		    0,
+		    0,
+		    command.argument
+		);
+
+		auto start = steady_clock::now();
+		result.queued = duration_cast<microseconds>(start - command.enqueued);
+
+		auto& manager = s_plugify->GetManager();
+		// The set about to be terminated, after Terminate() the manager no longer lists it
+		if (command.type != PlugifyCommandType::Load && manager.IsInitialized()) {
+			RecordExtensions(manager);
+		}
+
+		// Anything that initializes the manager reads every environment under envs/
+		auto idle = command.type == PlugifyCommandType::Unload || command.type == PlugifyCommandType::Swap
+		                ? Result<void>{}
+		                : CheckEnvironmentIdle(EnvironmentDir({}));
+		switch (command.type) {
+			case PlugifyCommandType::Load: {
+				if (manager.IsInitialized()) {
+					result.status = PlugifyCommandStatus::Skipped;
+					result.message = "Plugin manager already loaded.";
+				} else if (!idle) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(idle.error());
+				} else if (auto initResult = manager.Initialize()) {
+					result.message = "Plugin manager was loaded.";
+				} else {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(initResult.error());
+				}
+				break;
+			}
+			case PlugifyCommandType::Unload: {
+				if (!manager.IsInitialized()) {
+					result.status = PlugifyCommandStatus::Skipped;
+					result.message = "Plugin manager already unloaded.";
+				} else {
+					manager.Terminate();
+					result.message = "Plugin manager was unloaded.";
+				}
+				break;
+			}
+			case PlugifyCommandType::Reload: {
+				if (!manager.IsInitialized()) {
+					result.status = PlugifyCommandStatus::Skipped;
+					result.message = "Plugin manager not loaded.";
+					break;
+				}
+				if (!idle) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(idle.error());
+					break;
+				}
+				manager.Terminate();
+				if (auto initResult = manager.Initialize()) {
+					result.message = "Plugin manager was reloaded.";
+				} else {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(initResult.error());
+				}
+				break;
+			}
+			case PlugifyCommandType::Swap: {
+				if (auto swapResult = ExecuteSwap(manager, command.argument)) {
+					result.message = std::move(*swapResult);
+				} else {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(swapResult.error());
+				}
+				break;
+			}
+			case PlugifyCommandType::ReloadOne: {
+				if (!manager.IsInitialized()) {
+					result.status = PlugifyCommandStatus::Skipped;
+					result.message = "Plugin manager not loaded.";
+					break;
+				}
+				if (!manager.FindExtension(command.argument)) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::format("Extension {} not found.", command.argument);
+					break;
+				}
+				if (!idle) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(idle.error());
+					break;
+				}
+				// Manager has no per-extension lifecycle, so cycle it and verify the target came back
+				manager.Terminate();
+				if (auto initResult = manager.Initialize(); !initResult) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::move(initResult.error());
+				} else if (auto ext = manager.FindExtension(command.argument); !ext) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::format("Extension {} missing after reload.", command.argument);
+				} else if (ext->HasErrors()) {
+					result.status = PlugifyCommandStatus::Failed;
+					result.message = std::format(
+					    "Extension {} reloaded with errors: {}",
+					    command.argument,
+					    plg::join(ext->GetErrors(), "; ")
+					);
+				} else {
+					result.message = std::format(
+					    "Extension {} was reloaded ({}).",
+					    command.argument,
+					    plg::enum_to_string(ext->GetState())
+					);
+				}
+				break;
+			}
+		}
+
+		result.elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+
+		S2_PROBE2(state__end, command.id, static_cast<int>(result.status));
+		FlightRecorder::Record(
+		    FlightRecorder::EventType::State,
+		    static_cast<uint16_t>(command.type),
+		    1 + static_cast<uint32_t>(result.status),
+		    static_cast<uint64_t>(result.elapsed.count()),
+		    command.argument
+		);
+		if (result.status == PlugifyCommandStatus::Succeeded && command.type != PlugifyCommandType::Unload) {
+			RecordExtensions(manager);
+		}
+		if (result.status != PlugifyCommandStatus::Skipped) {
+			Watchdog::RefreshModules();
+		}
+		return result;
+	}
+
+	void DrainCommands() {
+		constexpr size_t kMaxHistory = 32;
+
+		while (auto command = s_commands.Pop()) {
+			auto result = ExecuteCommand(*command);
+
+			switch (result.status) {
+				case PlugifyCommandStatus::Succeeded:
+					plg::print(
+					    "{}: {} {}",
+					    Colorize("Success", Colors::GREEN),
+					    result.message,
+					    Colorize(std::format("[#{} in {}]", result.id, FormatDuration(result.elapsed)), Colors::GRAY)
+					);
+					break;
+				case PlugifyCommandStatus::Skipped:
+					plg::print(
+					    "{}: {} {}",
+					    Colorize("Warning", Colors::YELLOW),
+					    result.message,
+					    Colorize(std::format("[#{} skipped]", result.id), Colors::GRAY)
+					);
+					break;
+				case PlugifyCommandStatus::Failed:
+					plg::print(
+					    "{}: {} {}",
+					    Colorize("Error", Colors::RED),
+					    result.message,
+					    Colorize(std::format("[#{} in {}]", result.id, FormatDuration(result.elapsed)), Colors::GRAY)
+					);
+					break;
+			}
+
+			s_commandHistory.push_back(std::move(result));
+			if (s_commandHistory.size() > kMaxHistory) {
+				s_commandHistory.pop_front();
+			}
+		}
+	}
+
+	void StartRuntimeTrace(int durationSeconds) {
+		if (!RuntimeTrace::Start(std::chrono::seconds(durationSeconds))) {
+			plg::print("{}: Trace capture is already running.", Colorize("Error", Colors::RED));
+			return;
+		}
+		RuntimeTrace::SetGameThread();
+		if (durationSeconds > 0) {
+			plg::print(
+			    "{}: Trace capture started for {}s.",
+			    Colorize("Info", Colors::BLUE),
+			    durationSeconds
+			);
+		} else {
+			plg::print(
+			    "{}: Trace capture started, run 'plugify trace stop' to write it.",
+			    Colorize("Info", Colors::BLUE)
+			);
+		}
+	}
+
+	void StopRuntimeTrace() {
+		fs::path gameDir(Plat_GetGameDirectory());
+		auto path = gameDir / BASE_PATH / "logs" / FormatFileName("trace", "json");
+		auto result = RuntimeTrace::Stop(path);
+		if (!result) {
+			plg::print("{}: {}", Colorize("Error", Colors::RED), result.error());
+			return;
+		}
+		plg::print(
+		    "{}: Trace with {} events from {} thread{} written to {}",
+		    Colorize("Success", Colors::GREEN),
+		    result->events,
+		    result->threads,
+		    result->threads != 1 ? "s" : "",
+		    plg::as_string(path)
+		);
+		if (result->dropped) {
+			plg::print(
+			    "{}: {} events dropped, per-thread buffers hold {} events.",
+			    Colorize("Warning", Colors::YELLOW),
+			    result->dropped,
+			    RuntimeTrace::kBufferEvents
+			);
+		}
+	}
+
+	void StartCommandRecording() {
+		if (!CommandRecorder::Start()) {
+			plg::print("{}: Command recording is already running.", Colorize("Error", Colors::RED));
+			return;
+		}
+		plg::print(
+		    "{}: Recording console commands, run 'plugify record stop' to write them.",
+		    Colorize("Info", Colors::BLUE)
+		);
+	}
+
+	void StopCommandRecording(const std::string& file) {
+		fs::path path = file.empty() ? FormatFileName("commands", "jsonl") : file;
+		if (path.is_relative()) {
+			path = fs::path(Plat_GetGameDirectory()) / BASE_PATH / "logs" / path;
+		}
+		auto result = CommandRecorder::Stop(path);
+		if (!result) {
+			plg::print("{}: {}", Colorize("Error", Colors::RED), result.error());
+			return;
+		}
+		plg::print(
+		    "{}: {} command{} written to {}",
+		    Colorize("Success", Colors::GREEN),
+		    *result,
+		    *result != 1 ? "s" : "",
+		    plg::as_string(path)
+		);
+	}
+
+	// 'plugify -o': the captured report goes to disk in one write, the console only gets the summary.
+	// The console is reachable over RCON, so the file has to stay inside logs/data.
+	void WriteReportFile(const std::string& file, std::string_view text) {
+		fs::path relative = fs::path(file).lexically_normal();
+		if (relative.empty() || relative.has_root_path() || relative.has_root_name()
+		    || std::find(relative.begin(), relative.end(), "..") != relative.end()) {
+			plg::print(
+			    "{}: Output path {} must be relative to logs/data and must not contain '..'.",
+			    Colorize("Error", Colors::RED),
+			    file
+			);
+			return;
+		}
+
+		auto dataDir = fs::path(Plat_GetGameDirectory()) / BASE_PATH / "logs" / "data";
+		std::error_code ec;
+		fs::create_directories(dataDir, ec);
+
+		// Symlinks inside logs/data could still lead out of it
+		std::error_code rootEc;
+		auto root = fs::weakly_canonical(dataDir, rootEc);
+		auto path = fs::weakly_canonical(dataDir / relative, ec);
+		auto [rootEnd, pathEnd] = std::mismatch(root.begin(), root.end(), path.begin(), path.end());
+		if (rootEc || ec || rootEnd != root.end() || pathEnd == path.end()) {
+			plg::print(
+			    "{}: Output path {} resolves outside of {}.",
+			    Colorize("Error", Colors::RED),
+			    file,
+			    plg::as_string(dataDir)
+			);
+			return;
+		}
+		fs::create_directories(path.parent_path(), ec);
+
+		auto content = AnsiColorParser::StripColors(text);
+		errno = 0;
+		std::ofstream out(path, std::ios::binary);
+		if (!out || !out.write(content.data(), static_cast<std::streamsize>(content.size())).flush()) {
+			plg::print(
+			    "{}: Failed to write {} - {}",
+			    Colorize("Error", Colors::RED),
+			    plg::as_string(path),
+			    std::strerror(errno)
+			);
+			return;
+		}
+		plg::print(
+		    "{}: {} bytes written to {}",
+		    Colorize("Success", Colors::GREEN),
+		    content.size(),
+		    plg::as_string(path)
+		);
+	}
+
+	void StartProfiler(int hz) {
+#if S2_PLATFORM_LINUX
+		if (auto result = SamplingProfiler::Start(hz); !result) {
+			plg::print("{}: {}", Colorize("Error", Colors::RED), result.error());
+			return;
+		}
+		plg::print(
+		    "{}: Sampling game thread at {} Hz, run 'plugify profile stop' to write it.",
+		    Colorize("Info", Colors::BLUE),
+		    hz
+		);
+#else
+		(void) hz;
+		plg::print("{}: Sampling profiler is only available on Linux.", Colorize("Error", Colors::RED));
+#endif
+	}
+
+	void StopProfiler() {
+#if S2_PLATFORM_LINUX
+		std::vector<const Extension*> extensions;
+		if (s_plugify->GetManager().IsInitialized()) {
+			extensions = s_plugify->GetManager().GetExtensions();
+		}
+
+		fs::path gameDir(Plat_GetGameDirectory());
+		auto path = gameDir / BASE_PATH / "logs" / FormatFileName("profile", "folded");
+		auto report = SamplingProfiler::Stop(path, extensions);
+		if (!report) {
+			plg::print("{}: {}", Colorize("Error", Colors::RED), report.error());
+			return;
+		}
+
+		plg::print(
+		    "{}: {} samples over {} written to {}",
+		    Colorize("Success", Colors::GREEN),
+		    report->samples,
+		    FormatDuration(report->elapsed),
+		    plg::as_string(path)
+		);
+		if (report->dropped) {
+			plg::print(
+			    "{}: {} samples dropped, buffer holds {} samples.",
+			    Colorize("Warning", Colors::YELLOW),
+			    report->dropped,
+			    SamplingProfiler::kMaxSamples
+			);
+		}
+		if (report->owners.empty()) {
+			return;
+		}
+
+		plg::print(SEPARATOR_LINE);
+		plg::print(
+		    "{} {}",
+		    Colorize(std::format("{:<40}", "Owner"), Colors::GRAY),
+		    Colorize(std::format("{:>10} {:>8}", "Samples", "CPU %"), Colors::GRAY)
+		);
+		plg::print(SEPARATOR_LINE);
+		for (const auto& [owner, samples] : report->owners) {
+			plg::print(
+			    "{:<40} {:>10} {:>7.1f}%",
+			    Truncate(owner, 39),
+			    samples,
+			    100.0 * static_cast<double>(samples) / static_cast<double>(report->samples)
+			);
+		}
+		plg::print(SEPARATOR_LINE);
+#else
+		plg::print("{}: Sampling profiler is only available on Linux.", Colorize("Error", Colors::RED));
+#endif
+	}
+
+	void ShowPerfCounters(bool disable, bool jsonOutput) {
+#if S2_PLATFORM_LINUX
+		if (disable) {
+			PerfCounters::Close();
+			plg::print("{}: Performance counters closed.", Colorize("Info", Colors::BLUE));
+			return;
+		}
+
+		if (!PerfCounters::IsOpen()) {
+			if (auto result = PerfCounters::Open(); !result) {
+				plg::print("{}: {}", Colorize("Error", Colors::RED), result.error());
+				return;
+			}
+			plg::print(
+			    "{}: Performance counters opened on the game thread, data is aggregated per second.",
+			    Colorize("Info", Colors::BLUE)
+			);
+			return;
+		}
+
+		using Counter = PerfCounters::Counter;
+		constexpr std::pair<Counter, std::string_view> counters[] = {
+			{ Counter::Instructions, "instructions" },
+			{ Counter::Cycles, "cycles" },
+			{ Counter::CacheMisses, "cache_misses" },
+			{ Counter::ContextSwitches, "context_switches" },
+		};
+
+		const auto& last = PerfCounters::Last();
+		const auto& total = PerfCounters::Total();
+
+		if (jsonOutput) {
+			glz::json_t j;
+			auto fill = [&](glz::json_t& out, const PerfCounters::Window& window) {
+				out["ticks"] = window.ticks;
+				out["elapsed_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(window.elapsed).count();
+				for (const auto& [counter, name] : counters) {
+					if (PerfCounters::Has(counter)) {
+						out[std::string(name)] = window.values[counter];
+					}
+				}
+			};
+			fill(j["last_second"], last);
+			fill(j["total"], total);
+			plg::print(*j.dump());
+			return;
+		}
+
+		auto perTick = [](const PerfCounters::Window& window, Counter counter) {
+			return window.ticks ? window.values[counter] / window.ticks : 0;
+		};
+
+		plg::print(
+		    "{}: {} ticks in the last second, {} in total",
+		    Colorize("UPDATE() COUNTERS", Colors::ORANGE),
+		    last.ticks,
+		    total.ticks
+		);
+		plg::print(SEPARATOR_LINE);
+		plg::print(
+		    "{} {} {} {}",
+		    Colorize(std::format("{:<20}", "Counter"), Colors::GRAY),
+		    Colorize(std::format("{:>18}", "Last second"), Colors::GRAY),
+		    Colorize(std::format("{:>14}", "Per tick"), Colors::GRAY),
+		    Colorize(std::format("{:>18}", "Total"), Colors::GRAY)
+		);
+		plg::print(SEPARATOR_LINE);
+		for (const auto& [counter, name] : counters) {
+			if (!PerfCounters::Has(counter)) {
+				plg::print("{:<20} {}", name, Colorize("unavailable", Colors::GRAY));
+				continue;
+			}
+			plg::print(
+			    "{:<20} {:>18} {:>14} {:>18}",
+			    name,
+			    last.values[counter],
+			    perTick(last, counter),
+			    total.values[counter]
+			);
+		}
+		plg::print(SEPARATOR_LINE);
+
+		if (PerfCounters::Has(Counter::Instructions) && PerfCounters::Has(Counter::Cycles)
+		    && last.values[Counter::Cycles] > 0) {
+			plg::print(
+			    "  IPC: {:.2f}",
+			    static_cast<double>(last.values[Counter::Instructions])
+			        / static_cast<double>(last.values[Counter::Cycles])
+			);
+		}
+		if (PerfCounters::Has(Counter::Instructions) && PerfCounters::Has(Counter::CacheMisses)
+		    && last.values[Counter::Instructions] > 0) {
+			plg::print(
+			    "  Cache misses per 1k instructions: {:.2f}",
+			    1000.0 * static_cast<double>(last.values[Counter::CacheMisses])
+			        / static_cast<double>(last.values[Counter::Instructions])
+			);
+		}
+#else
+		(void) disable;
+		(void) jsonOutput;
+		plg::print("{}: Performance counters are only available on Linux.", Colorize("Error", Colors::RED));
+#endif
+	}
+
+	void ShowCommandQueue(bool jsonOutput) {
+		if (jsonOutput) {
+			glz::json_t j;
+			j["pending"] = s_commands.Pending();
+			glz::json_t::array_t history;
+			history.reserve(s_commandHistory.size());
+			for (const auto& result : s_commandHistory) {
+				glz::json_t entry;
+				entry["id"] = result.id;
+				entry["type"] = plg::enum_to_string(result.type);
+				if (!result.argument.empty()) {
+					entry["argument"] = result.argument;
+				}
+				entry["status"] = plg::enum_to_string(result.status);
+				entry["message"] = result.message;
+				entry["queued_us"] = result.queued.count();
+				entry["elapsed_us"] = result.elapsed.count();
+				history.emplace_back(std::move(entry));
+			}
+			j["history"] = std::move(history);
+			plg::print(*j.dump());
+			return;
+		}
+
+		plg::print(
+		    "{}: {} pending",
+		    Colorize("COMMAND QUEUE", Colors::ORANGE),
+		    s_commands.Pending()
+		);
+		plg::print(SEPARATOR_LINE);
+
+		if (s_commandHistory.empty()) {
+			plg::print(Colorize("No commands executed yet.", Colors::GRAY));
+			plg::print(SEPARATOR_LINE);
+			return;
+		}
+
+		plg::print(
+		    "{} {} {} {} {}",
+		    Colorize(std::format("{:<6}", Icons.Number), Colors::GRAY),
+		    Colorize(std::format("{:<20}", "Command"), Colors::GRAY),
+		    Colorize(std::format("{:<12}", "Status"), Colors::GRAY),
+		    Colorize(std::format("{:<12}", "Queued"), Colors::GRAY),
+		    Colorize(std::format("{:<12}", "Elapsed"), Colors::GRAY)
+		);
+		plg::print(SEPARATOR_LINE);
+
+		for (const auto& result : s_commandHistory) {
+			auto label = result.argument.empty()
+			                 ? std::string(plg::enum_to_string(result.type))
+			                 : std::format("{} {}", plg::enum_to_string(result.type), result.argument);
+			ColorCode color = result.status == PlugifyCommandStatus::Succeeded ? Colors::GREEN
+			                  : result.status == PlugifyCommandStatus::Skipped ? Colors::YELLOW
+			                                                                   : Colors::RED;
+			plg::print(
+			    "{:<6} {:<20} {} {:<12} {:<12}",
+			    result.id,
+			    Truncate(label, 19),
+			    Colorize(std::format("{:<12}", plg::enum_to_string(result.status)), color),
+			    FormatDuration(result.queued),
+			    FormatDuration(result.elapsed)
+			);
+		}
+		plg::print(SEPARATOR_LINE);
+	}
+
+	std::string DescribeFlightEvent(const FlightRecorder::Event& event) {
+		using EventType = FlightRecorder::EventType;
+		constexpr const char* kCommandNames[] = { "Load", "Unload", "Reload", "ReloadOne", "Swap" };
+		constexpr const char* kStatusNames[] = { "succeeded", "failed", "skipped" };
+
+		switch (event.type) {
+			case EventType::State: {
+				auto name = event.code < std::size(kCommandNames) ? kCommandNames[event.code] : "?";
+				auto label = event.text.empty() ? std::string(name) : std::format("{} {}", name, event.text);
+				if (event.arg == 0) {
+					return std::format("{} begin", label);
+				}
+				auto status = event.arg - 1 < std::size(kStatusNames) ? kStatusNames[event.arg - 1] : "?";
+				return std::format("{} {} in {}", label, status, FormatDuration(std::chrono::microseconds(event.value)));
+			}
+			case EventType::Command:
+				return event.text;
+			case EventType::Extension:
+				return std::format("{} {}", event.text, plg::enum_to_string(static_cast<ExtensionState>(event.code)));
+			case EventType::Log:
+				return std::format("[{}] {}", plg::enum_to_string(static_cast<Severity>(event.code)), event.text);
+			case EventType::Stall:
+				if (event.code == 1) {
+					return std::format("{} stall, terminated", FormatDuration(std::chrono::milliseconds(event.value)));
+				}
+				return std::format("{} in {}", FormatDuration(std::chrono::milliseconds(event.value)), event.text);
+			default:
+				return {};
+		}
+	}
+
+	// Decodes the live ring, or a ring file such as the flight.bin attached to a crash report
+	void ShowFlightRecorder(const std::string& file, size_t last, bool jsonOutput) {
+		Result<FlightRecorder::Snapshot> result;
+		fs::path path;
+		if (file.empty()) {
+			result = FlightRecorder::Capture();
+		} else {
+			path = file;
+			if (path.is_relative()) {
+				path = fs::path(Plat_GetGameDirectory()) / BASE_PATH / "logs" / path;
+			}
+			result = FlightRecorder::Load(path);
+		}
+
+		if (!result) {
+			plg::print("{}: {}", Colorize("Error", Colors::RED), result.error());
+			return;
+		}
+
+		const auto& snapshot = *result;
+		std::span events(snapshot.events);
+		if (last > 0 && events.size() > last) {
+			events = events.last(last);
+		}
+
+		uint64_t tickTotal = 0;
+		uint32_t tickMax = 0;
+		for (auto duration : snapshot.tickDurations) {
+			tickTotal += duration;
+			tickMax = std::max(tickMax, duration);
+		}
+		auto tickAvg = snapshot.tickDurations.empty() ? 0 : tickTotal / snapshot.tickDurations.size();
+
+		if (jsonOutput) {
+			glz::json_t j;
+			j["start"] = std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::milliseconds>(snapshot.start));
+			j["capacity"] = snapshot.capacity;
+			j["recorded"] = snapshot.recorded;
+			j["ticks"] = snapshot.ticks;
+			j["tick_avg_us"] = tickAvg;
+			j["tick_max_us"] = tickMax;
+			glz::json_t::array_t durations;
+			durations.reserve(snapshot.tickDurations.size());
+			for (auto duration : snapshot.tickDurations) {
+				durations.emplace_back(static_cast<double>(duration));
+			}
+			j["tick_durations_us"] = std::move(durations);
+			glz::json_t severities;
+			for (size_t i = 0; i < snapshot.severities.size(); ++i) {
+				if (snapshot.severities[i] > 0) {
+					severities[std::string(plg::enum_to_string(static_cast<Severity>(i)))] = snapshot.severities[i];
+				}
+			}
+			j["severities"] = std::move(severities);
+			glz::json_t::array_t list;
+			list.reserve(events.size());
+			for (const auto& event : events) {
+				glz::json_t entry;
+				entry["seq"] = event.sequence;
+				entry["time_ns"] = event.time.count();
+				entry["type"] = plg::enum_to_string(event.type);
+				entry["code"] = event.code;
+				entry["arg"] = event.arg;
+				entry["value"] = event.value;
+				entry["text"] = event.text;
+				entry["detail"] = DescribeFlightEvent(event);
+				list.emplace_back(std::move(entry));
+			}
+			j["events"] = std::move(list);
+			plg::print(*j.dump());
+			return;
+		}
+
+		plg::print(
+		    "{}: {}",
+		    Colorize("FLIGHT RECORDER", Colors::ORANGE),
+		    path.empty() ? "live" : plg::as_string(path)
+		);
+		plg::print(SEPARATOR_LINE);
+		plg::print("  Session start:  {:%F %T}", std::chrono::floor<std::chrono::seconds>(snapshot.start));
+		plg::print(
+		    "  Events:         {} recorded, {} retained (capacity {})",
+		    snapshot.recorded,
+		    snapshot.events.size(),
+		    snapshot.capacity
+		);
+		plg::print(
+		    "  Ticks:          {} total, last {} avg {} max {}",
+		    snapshot.ticks,
+		    snapshot.tickDurations.size(),
+		    FormatDuration(std::chrono::microseconds(tickAvg)),
+		    FormatDuration(std::chrono::microseconds(tickMax))
+		);
+
+		std::string severities;
+		for (size_t i = 0; i < snapshot.severities.size(); ++i) {
+			if (snapshot.severities[i] > 0) {
+				std::format_to(
+				    std::back_inserter(severities),
+				    "{}{} {}",
+				    severities.empty() ? "" : ", ",
+				    plg::enum_to_string(static_cast<Severity>(i)),
+				    snapshot.severities[i]
+				);
+			}
+		}
+		plg::print("  Log messages:   {}", severities.empty() ? "none" : severities);
+		plg::print(SEPARATOR_LINE);
+
+		if (events.empty()) {
+			plg::print(Colorize("No events recorded.", Colors::GRAY));
+			plg::print(SEPARATOR_LINE);
+			return;
+		}
+
+		plg::print(
+		    "{} {} {}",
+		    Colorize(std::format("{:<12}", "Time"), Colors::GRAY),
+		    Colorize(std::format("{:<10}", "Event"), Colors::GRAY),
+		    Colorize("Detail", Colors::GRAY)
+		);
+		plg::print(SEPARATOR_LINE);
+
+		for (const auto& event : events) {
+			ColorCode color = event.type == FlightRecorder::EventType::Log || event.type == FlightRecorder::EventType::Stall
+			                      ? Colors::RED
+			                      : Colors::WHITE;
+			plg::print(
+			    "{:<12} {} {}",
+			    std::format("+{:.3f}s", std::chrono::duration<double>(event.time).count()),
+			    Colorize(std::format("{:<10}", plg::enum_to_string(event.type)), color),
+			    DescribeFlightEvent(event)
+			);
+		}
+		plg::print(SEPARATOR_LINE);
+	}
+
+	// --page/--limit/--offset of the large listings
+	struct PageOptions {
+		size_t page = 0;    // 1-based, pages are 'limit' entries long
+		size_t offset = 0;  // entries (tree lines) to skip before the page
+		size_t limit = 0;   // 0 = everything
+
+		static constexpr size_t kDefaultPageSize = 50;
+
+		size_t First() const {
+			return offset + (page > 0 ? (page - 1) * Size() : 0);
+		}
+
+		size_t Size() const {
+			return limit ? limit : (page > 0 ? kDefaultPageSize : 0);
+		}
+
+		bool Slices() const {
+			return page || offset || limit;
+		}
+	};
+
+	// Drops everything outside the requested slice, returns the index of the first kept entry
+	template <typename T>
+	size_t ApplyPage(std::pmr::vector<T>& items, const PageOptions& page) {
+		auto first = std::min(page.First(), items.size());
+		items.erase(items.begin(), items.begin() + static_cast<ptrdiff_t>(first));
+		if (page.Size() && items.size() > page.Size()) {
+			items.resize(page.Size());
+		}
+		return first;
+	}
+
+	// Prints a finished report, going through the pager when it is too big for one tick (or
+	// when earlier paged output is still pending, to keep the order). Without the tick hook
+	// nothing would drain the pager, so the report is printed directly.
+	void EmitReport(std::string text) {
+		if (!OutputCapture::Active() && ConsolePager::Attached()
+		    && (ConsolePager::Busy() || !ConsolePager::Fits(text))) {
+			ConsolePager::Enqueue(std::move(text));
+		} else {
+			plg::print(std::move(text));
+		}
+	}
+
+	// Column layout shared by 'plugify plugins' and 'plugify modules'
+	Table ExtensionTable() {
+		return Table{
+			{ Icons.Number, 3 },
+			{ "Name", 24 },
+			{ "Version", 14 },
+			{ "State", 12 },
+			{ "Lang", 7 },
+			{ "Load Time" },
+		};
+	}
+
+	void AddExtensionRow(Table& table, const Extension* ext, size_t index, std::string_view name) {
+		auto state = ext->GetState();
+		auto [symbol, color] = GetStateInfo(state);
+
+		// Get load time if available
+		std::string loadTime = "N/A";
+		try {
+			auto duration = ext->GetOperationTime(ExtensionState::Loaded);
+			if (duration.count() > 0) {
+				loadTime = FormatDuration(duration);
+			}
+		} catch (...) {
+		}
+
+		table.Cell(index).Cell(name).Cell(ext->GetVersionString());
+		table.Cell(symbol, color).Append(" ").Append(plg::enum_to_string(state));
+		table.Cell(ext->GetLanguage()).Cell(loadTime);
+
+		// Show errors/warnings if any
+		if (ext->HasErrors()) {
+			for (const auto& error : ext->GetErrors()) {
+				table.Note("Error", Colors::RED, error);
+			}
+		}
+		if (ext->HasWarnings()) {
+			for (const auto& warning : ext->GetWarnings()) {
+				table.Note("Warning", Colors::YELLOW, warning);
+			}
+		}
+	}
+
+	// Title, status and the general information blocks of 'plugify plugin|module'
+	void AppendExtensionHeader(ReportBuffer& report, const Extension* ext, std::string_view title, ColorCode nameColor) {
+		report.Line(DOUBLE_LINE);
+		report.Append(title, Colors::ORANGE).Append(": ").Line(ext->GetName(), nameColor);
+		report.Line(DOUBLE_LINE);
+
+		// Status indicator
+		auto [symbol, stateColor] = GetStateInfo(ext->GetState());
+		report.Line().Append(symbol, stateColor).Spaces(1).Append("Status:", Colors::ORANGE).Spaces(1);
+		report.Line(plg::enum_to_string(ext->GetState()), stateColor);
+
+		// Basic Information
+		report.Line().Line("[Basic Information]", Colors::CYAN);
+		report.Spaces(2).Pad("ID:", ReportBuffer::kLabelWidth, Colors::GRAY).Format(" {}\n", ext->GetId());
+		report.Field("Name:", ext->GetName());
+		report.Field("Version:", ext->GetVersionString(), Colors::GREEN);
+		report.Field("Language:", ext->GetLanguage());
+		report.Field("Location:", plg::as_string(ext->GetLocation()));
+		report.Field("File Size:", FormatFileSize(ext->GetLocation()));
+
+		// Optional Information
+		if (!ext->GetDescription().empty() || !ext->GetAuthor().empty()
+		    || !ext->GetWebsite().empty() || !ext->GetLicense().empty()) {
+			report.Line().Line("[Additional Information]", Colors::CYAN);
+			if (!ext->GetDescription().empty()) {
+				report.Field("Description:", ext->GetDescription());
+			}
+			if (!ext->GetAuthor().empty()) {
+				report.Field("Author:", ext->GetAuthor(), Colors::MAGENTA);
+			}
+			if (!ext->GetWebsite().empty()) {
+				report.Field("Website:", ext->GetWebsite(), Colors::BLUE);
+			}
+			if (!ext->GetLicense().empty()) {
+				report.Field("License:", ext->GetLicense());
+			}
+		}
+	}
+
+	// Platforms, dependencies, conflicts, timings and issues of 'plugify plugin|module'
+	void AppendExtensionFooter(ReportBuffer& report, const Extension* ext) {
+		// Platforms
+		const auto& platforms = ext->GetPlatforms();
+		if (!platforms.empty()) {
+			report.Line().Line("[Supported Platforms]", Colors::CYAN);
+			report.Spaces(2).Line(plg::join(platforms, ", "), Colors::GREEN);
+		}
+
+		// Dependencies
+		const auto& deps = ext->GetDependencies();
+		if (!deps.empty()) {
+			report.Line().Append("[Dependencies]", Colors::CYAN);
+			report.FormatColor(Colors::GRAY, " ({} total)", deps.size()).Line();
+			for (const auto& dep : deps) {
+				report.Spaces(2);
+				if (dep.IsOptional()) {
+					report.Append(Icons.Skipped, Colors::GRAY);
+				} else {
+					report.Append(Icons.Valid, Colors::GREEN);
+				}
+				report.Spaces(1).Append(dep.GetName(), Colors::ORANGE).Spaces(1);
+				report.Line(dep.GetConstraints().to_string(), Colors::GRAY);
+				if (dep.IsOptional()) {
+					report.Append("    └─ ").Line("Optional", Colors::GRAY);
+				}
+			}
+		}
+
+		// Conflicts
+		const auto& conflicts = ext->GetConflicts();
+		if (!conflicts.empty()) {
+			report.Line().Append("[Conflicts]", Colors::YELLOW);
+			report.FormatColor(Colors::GRAY, " ({} total)", conflicts.size()).Line();
+			for (const auto& conflict : conflicts) {
+				report.Spaces(2).Append(Icons.Warning, Colors::YELLOW).Spaces(1).Append(conflict.GetName()).Spaces(1);
+				report.Line(conflict.GetConstraints().to_string(), Colors::GRAY);
+				if (!conflict.GetReason().empty()) {
+					report.Append("    └─ ").Line(conflict.GetReason(), Colors::RED);
+				}
+			}
+		}
+
+		// Performance Information
+		report.Line().Line("[Performance Metrics]", Colors::CYAN);
+		auto totalTime = ext->GetTotalTime();
+		report.Field(
+		    "Total Time:",
+		    FormatDuration(totalTime),
+		    totalTime > std::chrono::seconds(1) ? Colors::YELLOW : Colors::GREEN
+		);
+
+		// Show timing for different operations
+		ExtensionState operations[] = {
+			ExtensionState::Parsing,
+			ExtensionState::Resolving,
+			ExtensionState::Loading,
+			ExtensionState::Starting,
+		};
+
+		for (const auto& op : operations) {
+			try {
+				auto duration = ext->GetOperationTime(op);
+				if (duration.count() > 0) {
+					bool slow = duration > std::chrono::milliseconds(500);
+					auto label = plg::enum_to_string(op);
+					auto width = DisplayWidth(label) + 1;
+					report.Spaces(2).FormatColor(Colors::GRAY, "{}:", label);
+					report.Spaces(width < ReportBuffer::kLabelWidth ? ReportBuffer::kLabelWidth - width + 1 : 1);
+					report.Line(FormatDuration(duration), slow ? Colors::YELLOW : Colors::GREEN);
+				}
+			} catch (...) {
+			}
+		}
+
+		// Errors and Warnings
+		if (ext->HasErrors() || ext->HasWarnings()) {
+			report.Line().Line("[Issues]", Colors::RED);
+			for (const auto& error : ext->GetErrors()) {
+				report.Spaces(2).Append("ERROR:", Colors::RED).Spaces(1).Line(error);
+			}
+			for (const auto& warning : ext->GetWarnings()) {
+				report.Spaces(2).Append("WARNING:", Colors::YELLOW).Spaces(1).Line(warning);
+			}
+		} else {
+			report.Line().Append(Icons.Ok, Colors::GREEN).Spaces(1).Line("No issues detected", Colors::GREEN);
+		}
+
+		report.Line(DOUBLE_LINE);
+	}
+
+	void ListPlugins(
+	    const FilterOptions& filter = {},
+	    SortBy sortBy = SortBy::Name,
+	    bool reverseSort = false,
+	    bool jsonOutput = false,
+	    const PageOptions& page = {}
+	) {
+		if (!CheckManager()) {
+			return;
+		}
+
+		const auto& manager = s_plugify->GetManager();
+		auto plugins = manager.GetExtensionsByType(ExtensionType::Plugin);
+
+		// Apply filters
+		auto filtered = FilterExtensions(plugins, filter);
+		SortExtensions(filtered, sortBy, reverseSort);
+		auto matched = filtered.size();
+		auto first = ApplyPage(filtered, page);
+
+		// Output
+		if (jsonOutput) {
+			glz::json_t::array_t objects;
+			objects.reserve(filtered.size());
+			for (const auto& plugin : filtered) {
+				objects.emplace_back(ExtensionToJson(plugin));
+			}
+			EmitReport(*glz::json_t{ std::move(objects) }.dump());
+			return;
+		}
+
+		auto count = filtered.size();
+		if (!count) {
+			plg::print(Colorize("No plugins found matching criteria.", Colors::YELLOW));
+			return;
+		}
+
+		Table table = ExtensionTable();
+		size_t index = first + 1;
+		for (const auto& plugin : filtered) {
+			const auto& name = !plugin->GetName().empty()
+			                       ? plugin->GetName()
+			                       : plg::as_string(plugin->GetLocation().filename());
+			AddExtensionRow(table, plugin, index++, name);
+		}
+
+		ReportBuffer report;
+		report.FormatColor(Colors::ORANGE, "Listing {} plugin{}", count, (count > 1) ? "s" : "");
+		if (page.Slices()) {
+			report.FormatColor(Colors::GRAY, " ({}-{} of {})", first + 1, first + count, matched);
+		}
+		report.Line(":");
+		report.Line(SEPARATOR_LINE);
+		table.Render(report, SEPARATOR_LINE);
+		report.Line(SEPARATOR_LINE);
+
+		// Summary
+		if (filter.states.has_value() || filter.languages.has_value()
+		    || filter.searchQuery.has_value() || filter.showOnlyFailed) {
+			report.FormatColor(Colors::GRAY, "Filtered: {} of {} total plugins shown", matched, plugins.size());
+		}
+		EmitReport(report.Take());
+	}
+
+	void ListModules(
+	    const FilterOptions& filter = {},
+	    SortBy sortBy = SortBy::Name,
+	    bool reverseSort = false,
+	    bool jsonOutput = false,
+	    const PageOptions& page = {}
+	) {
+		if (!CheckManager()) {
+			return;
+		}
+
+		const auto& manager = s_plugify->GetManager();
+		auto modules = manager.GetExtensionsByType(ExtensionType::Module);
+
+		// Apply filters
+		auto filtered = FilterExtensions(modules, filter);
+		SortExtensions(filtered, sortBy, reverseSort);
+		auto matched = filtered.size();
+		auto first = ApplyPage(filtered, page);
+
+		// Output
+		if (jsonOutput) {
+			glz::json_t::array_t objects;
+			objects.reserve(filtered.size());
+			for (const auto& module : filtered) {
+				objects.emplace_back(ExtensionToJson(module));
+			}
+			EmitReport(*glz::json_t{ std::move(objects) }.dump());
+			return;
+		}
+
+		auto count = filtered.size();
+		if (!count) {
+			plg::print(Colorize("No modules found matching criteria.", Colors::YELLOW));
+			return;
+		}
+
+		Table table = ExtensionTable();
+		size_t index = first + 1;
+		for (const auto& module : filtered) {
+			AddExtensionRow(table, module, index++, module->GetName());
+		}
+
+		ReportBuffer report;
+		report.FormatColor(Colors::ORANGE, "Listing {} module{}", count, (count > 1) ? "s" : "");
+		if (page.Slices()) {
+			report.FormatColor(Colors::GRAY, " ({}-{} of {})", first + 1, first + count, matched);
+		}
+		report.Line(":");
+		report.Line(SEPARATOR_LINE);
+		table.Render(report, SEPARATOR_LINE);
+		report.Line(SEPARATOR_LINE);
+
+		// Summary
+		if (filter.states.has_value() || filter.languages.has_value()
+		    || filter.searchQuery.has_value() || filter.showOnlyFailed) {
+			report.FormatColor(Colors::GRAY, "Filtered: {} of {} total modules shown", matched, modules.size());
+		}
+		EmitReport(report.Take());
+	}
+
+	void ShowPlugin(std::string_view identifier, bool plugin_use_id, bool jsonOutput) {
+		if (!CheckManager()) {
+			return;
+		}
+
+		const auto& manager = s_plugify->GetManager();
+		auto plugin = plugin_use_id ? manager.FindExtension(FormatId(identifier))
+		                            : manager.FindExtension(identifier);
+
+		if (!plugin) {
+			if (jsonOutput) {
+				glz::json_t error;
+				error["error"] = std::format("Plugin {} not found", identifier);
+				plg::print(*error.dump());
+			} else {
+				plg::print("{}: Plugin {} not found.", Colorize("Error", Colors::RED), identifier);
+			}
+			return;
+		}
+
+		if (!plugin->IsPlugin()) {
+			if (jsonOutput) {
+				glz::json_t error;
+				error["error"] = std::format("'{}' is not a plugin (it's a module)", identifier);
+				plg::print(*error.dump());
+			} else {
+				plg::print(
+				    "{}: '{}' is not a plugin (it's a module).",
+				    Colorize("Error", Colors::RED),
+				    identifier
+				);
+			}
+			return;
+		}
+
+		// JSON output
+		if (jsonOutput) {
+			plg::print(*ExtensionToJson(plugin).dump());
+			return;
+		}
+
+		// Display detailed plugin information with colors
+		ReportBuffer report;
+		AppendExtensionHeader(report, plugin, "PLUGIN INFORMATION", Colors::CYAN);
+
+		// Plugin-specific information
+		if (!plugin->GetEntry().empty()) {
+			report.Line().Line("[Plugin Details]", Colors::CYAN);
+			report.Field("Entry Point:", plugin->GetEntry(), Colors::YELLOW);
+		}
+
+		// Methods
+		const auto& methods = plugin->GetMethods();
+		if (!methods.empty()) {
+			report.Line().Append("[Exported Methods]", Colors::CYAN);
+			report.FormatColor(Colors::GRAY, " ({} total)", methods.size()).Line();
+
+			size_t displayCount = std::min<size_t>(methods.size(), 10);
+			for (size_t i = 0; i < displayCount; ++i) {
+				const auto& method = methods[i];
+				report.Spaces(2).Append(Icons.Number, Colors::GRAY).Format("{:<2} ", i + 1);
+				report.Line(method.GetName(), Colors::GREEN);
+				if (!method.GetFuncName().empty()) {
+					report.Spaces(6).Append("Func Name:", Colors::GRAY).Spaces(1).Line(method.GetFuncName());
+				}
+			}
+			if (methods.size() > 10) {
+				report.Spaces(2).Append(Icons.Arrow, Colors::GRAY);
+				report.Format(" ... and {} more methods\n", methods.size() - 10);
+			}
+		}
+
+		AppendExtensionFooter(report, plugin);
+		plg::print(report.Take());
+	}
+
+	void ShowModule(std::string_view identifier, bool module_use_id, bool jsonOutput) {
+		if (!CheckManager()) {
+			return;
+		}
+
+		const auto& manager = s_plugify->GetManager();
+		auto module = module_use_id ? manager.FindExtension(FormatId(identifier))
+		                            : manager.FindExtension(identifier);
+
+		if (!module) {
+			if (jsonOutput) {
+				glz::json_t error;
+				error["error"] = std::format("Module {} not found", identifier);
+				plg::print(*error.dump());
+			} else {
+				plg::print("{}: Module {} not found.", Colorize("Error", Colors::RED), identifier);
+			}
+			return;
+		}
+
+		if (!module->IsModule()) {
+			if (jsonOutput) {
+				glz::json_t error;
+				error["error"] = std::format("'{}' is not a module (it's a plugin)", identifier);
+				plg::print(*error.dump());
+			} else {
+				plg::print(
+				    "{}: '{}' is not a module (it's a plugin).",
+				    Colorize("Error", Colors::RED),
+				    identifier
+				);
+			}
+			return;
+		}
+
+		// JSON output
+		if (jsonOutput) {
+			plg::print(*ExtensionToJson(module).dump());
+			return;
+		}
+
+		// Display detailed module information with colors
+		ReportBuffer report;
+		AppendExtensionHeader(report, module, "MODULE INFORMATION", Colors::MAGENTA);
+
+		// Module-specific information
+		if (!module->GetRuntime().empty()) {
+			report.Line().Line("[Module Details]", Colors::CYAN);
+			report.Field("Runtime:", plg::as_string(module->GetRuntime()), Colors::YELLOW);
+		}
+
+		// Directories
+		const auto& dirs = module->GetDirectories();
+		if (!dirs.empty()) {
+			report.Line().Append("[Search Directories]", Colors::CYAN);
+			report.FormatColor(Colors::GRAY, " ({} total)", dirs.size()).Line();
+
+			size_t displayCount = std::min<size_t>(dirs.size(), 5);
+			for (size_t i = 0; i < displayCount; ++i) {
+				std::error_code ec;
+				bool exists = fs::exists(dirs[i], ec);
+				report.Spaces(2);
+				if (exists) {
+					report.Append(Icons.Ok, Colors::GREEN);
+				} else {
+					report.Append(Icons.Fail, Colors::RED);
+				}
+				report.Spaces(1).Line(plg::as_string(dirs[i]));
+			}
+			if (dirs.size() > 5) {
+				report.Spaces(2).Append(Icons.Arrow, Colors::GRAY);
+				report.Format(" ... and {} more directories\n", dirs.size() - 5);
+			}
+		}
+
+		// Assembly Information
+		if (auto assembly = module->GetAssembly()) {
+			report.Line().Line("[Assembly Information]", Colors::CYAN);
+			report.Spaces(2).Append(Icons.Ok, Colors::GREEN).Line(" Assembly loaded and active");
+			// Add more assembly details if available in your IAssembly interface
+		}
+
+		AppendExtensionFooter(report, module);
+		plg::print(report.Take());
+	}
+
+	void ShowHealth() {
+		if (!CheckManager()) {
+			return;
+		}
+
+		const auto& manager = s_plugify->GetManager();
+		auto health = CalculateSystemHealth(manager);
+
+		// Determine health status color
+		ColorCode scoreColor = Colors::GREEN;
+		std::string_view status = "HEALTHY";
+		if (health.score < 50) {
+			scoreColor = Colors::RED;
+			status = "CRITICAL";
+		} else if (health.score < 75) {
+			scoreColor = Colors::YELLOW;
+			status = "WARNING";
+		}
+
+		ReportBuffer report;
+		report.Line(DOUBLE_LINE);
+		report.Line("SYSTEM HEALTH CHECK", Colors::ORANGE);
+		report.Line(DOUBLE_LINE);
+
+		// Overall score
+		report.Line().Append("Overall Health Score", Colors::ORANGE).Append(": ");
+		report.FormatColor(scoreColor, "{}/100", health.score).Spaces(1);
+		report.FormatColor(scoreColor, "[{}]", status).Line();
+
+		// Statistics
+		auto& stats = health.statistics;
+		auto mark = [&report](size_t value, ColorCode color) {
+			report.Format(" {} ", value);
+			report.Line(value > 0 ? Icons.Warning : Icons.Ok, value > 0 ? color : Colors::GREEN);
+		};
+		report.Line().Line("[Statistics]", Colors::CYAN);
+		report.Format("  Total Extensions:        {}\n", stats["total_extensions"]);
+		report.Append("  Failed Extensions:      ");
+		mark(stats["failed_extensions"], Colors::RED);
+		report.Append("  Extensions with Errors: ");
+		mark(stats["extensions_with_errors"], Colors::YELLOW);
+		report.Format("  Total Warnings:          {}\n", stats["total_warnings"]);
+		report.Format("  Slow Loading Extensions: {}\n", stats["slow_loading_extensions"]);
+
+		// Issues
+		if (!health.issues.empty()) {
+			report.Line().Line("[Critical Issues]", Colors::RED);
+			for (const auto& issue : health.issues) {
+				report.Spaces(2).Append(Icons.Fail, Colors::RED).Spaces(1).Line(issue);
+			}
+		}
+
+		// Warnings
+		if (!health.warnings.empty()) {
+			report.Line().Line("[Warnings]", Colors::YELLOW);
+			for (const auto& warning : health.warnings) {
+				report.Spaces(2).Append(Icons.Warning, Colors::YELLOW).Spaces(1).Line(warning);
+			}
 		}
-		const auto& manager = s_plugify->GetManager();
-		if (!manager.IsInitialized()) {
-			plg::print("{}: Plugin manager not loaded.", Colorize("Warning", Colors::YELLOW));
+
+		// Recommendations
+		report.Line().Line("[Recommendations]", Colors::CYAN);
+		if (health.score == 100) {
+			report.Spaces(2).Append(Icons.Ok, Colors::GREEN).Line(" System is running optimally!");
 		} else {
-			s_state = PlugifyState::Reload;
+			if (stats["failed_extensions"] > 0) {
+				report.Line("  • Fix or remove failed extensions");
+			}
+			if (stats["extensions_with_errors"] > 0) {
+				report.Line("  • Review and resolve extension errors");
+			}
+			if (stats["slow_loading_extensions"] > 0) {
+				report.Line("  • Investigate slow-loading extensions for optimization");
+			}
 		}
+
+		report.Line(DOUBLE_LINE);
+		plg::print(report.Take());
 	}
 
-	void ListPlugins(
-	    const FilterOptions& filter = {},
-	    SortBy sortBy = SortBy::Name,
-	    bool reverseSort = false,
-	    bool jsonOutput = false
-	) {
+	void ShowDependencyTree(std::string_view name, bool useId = false, const PageOptions& page = {}) {
 		if (!CheckManager()) {
 			return;
 		}
 
 		const auto& manager = s_plugify->GetManager();
-		auto plugins = manager.GetExtensionsByType(ExtensionType::Plugin);
-
-		// Apply filters
-		auto filtered = FilterExtensions(plugins, filter);
-		SortExtensions(filtered, sortBy, reverseSort);
-
-		// Output
-		if (jsonOutput) {
-			glz::json_t::array_t objects;
-			objects.reserve(filtered.size());
-			for (const auto& plugin : filtered) {
-				objects.emplace_back(ExtensionToJson(plugin));
-			}
-			plg::print(*glz::json_t{ std::move(objects) }.dump());
-			return;
-		}
+		auto ext = useId ? manager.FindExtension(FormatId(name)) : manager.FindExtension(name);
 
-		auto count = filtered.size();
-		if (!count) {
-			plg::print(Colorize("No plugins found matching criteria.", Colors::YELLOW));
+		if (!ext) {
+			plg::print("{} {} not found.", Colorize("Error:", Colors::RED), name);
 			return;
 		}
 
-		plg::print(
-		    "{}:",
-		    Colorize(std::format("Listing {} plugin{}", count, (count > 1) ? "s" : ""), Colors::ORANGE)
-		);
-		plg::print(SEPARATOR_LINE);
-
-		// Header
-		plg::print(
-		    "{} {} {} {} {} {}",
-		    Colorize(std::format("{:<3}", Icons.Number), Colors::GRAY),
-		    Colorize(std::format("{:<25}", "Name"), Colors::GRAY),
-		    Colorize(std::format("{:<15}", "Version"), Colors::GRAY),
-		    Colorize(std::format("{:<12}", "State"), Colors::GRAY),
-		    Colorize(std::format("{:<8}", "Lang"), Colors::GRAY),
-		    Colorize(std::format("{:<12}", "Load Time"), Colors::GRAY)
-		);
-		plg::print(SEPARATOR_LINE);
+		ReportBuffer tree;
+		PrintDependencyTree(tree, ext, manager);
 
-		size_t index = 1;
-		for (const auto& plugin : filtered) {
-			auto state = plugin->GetState();
-			auto stateStr = plg::enum_to_string(state);
-			auto [symbol, color] = GetStateInfo(state);
-			const auto& name = !plugin->GetName().empty()
-			                       ? plugin->GetName()
-			                       : plg::as_string(plugin->GetLocation().filename());
+		ReportBuffer report(tree.Size() + 1024);
+		report.Line(DOUBLE_LINE);
+		report.Append("DEPENDENCY TREE", Colors::ORANGE).Append(": ").Line(ext->GetName());
+		report.Line(DOUBLE_LINE);
+		report.Line();
 
-			// Get load time if available
-			std::string loadTime = "N/A";
-			try {
-				auto duration = plugin->GetOperationTime(ExtensionState::Loaded);
-				if (duration.count() > 0) {
-					loadTime = FormatDuration(duration);
-				}
-			} catch (...) {
-			}
+		// Slicing applies to the tree lines only
+		if (page.Slices()) {
+			auto lines = CountLines(tree.View());
+			auto slice = SliceLines(tree.View(), page.First(), page.Size());
+			report.Append(slice);
+			auto first = std::min(page.First(), lines);
+			report.FormatColor(Colors::GRAY, "(lines {}-{} of {})", first + 1, first + CountLines(slice), lines).Line();
+		} else {
+			report.Append(tree.View());
+		}
 
-			plg::print(
-			    "{:<3} {:<25} {:<15} {} {:<11} {:<8} {:<12}",
-			    index++,
-			    Truncate(name, 24),
-			    plugin->GetVersionString(),
-			    Colorize(symbol, color),
-			    Truncate(std::string(stateStr), 10),
-			    Truncate(plugin->GetLanguage(), 7),
-			    loadTime
-			);
+		// Also show what depends on this extension
+		report.Line().Line("[Reverse Dependencies]", Colors::CYAN);
+		report.Line("Extensions that depend on this:");
 
-			// Show errors/warnings if any
-			if (plugin->HasErrors()) {
-				for (const auto& error : plugin->GetErrors()) {
-					plg::print("     └─ {}: {}", Colorize("Error", Colors::RED), error);
-				}
-			}
-			if (plugin->HasWarnings()) {
-				for (const auto& warning : plugin->GetWarnings()) {
-					plg::print("     └─ {}: {}", Colorize("Warning", Colors::YELLOW), warning);
+		bool found = false;
+		for (const auto& other : manager.GetExtensions()) {
+			for (const auto& dep : other->GetDependencies()) {
+				if (dep.GetName() == ext->GetName()) {
+					report.Append("  • ").Append(other->GetName());
+					if (dep.IsOptional()) {
+						report.Spaces(1).Append("[optional]", Colors::GRAY);
+					}
+					report.Line();
+					found = true;
 				}
 			}
 		}
-		plg::print(SEPARATOR_LINE);
 
-		// Summary
-		if (filter.states.has_value() || filter.languages.has_value()
-		    || filter.searchQuery.has_value() || filter.showOnlyFailed) {
-			plg::print(
-			    "{}",
-			    Colorize(
-			        std::format("Filtered: {} of {} total plugins shown", filtered.size(), plugins.size()),
-			        Colors::GRAY
-			    )
-			);
+		if (!found) {
+			report.Spaces(2).Line("None", Colors::GRAY);
 		}
+
+		report.Line(DOUBLE_LINE);
+		EmitReport(report.Take());
 	}
 
-	void ListModules(
-	    const FilterOptions& filter = {},
-	    SortBy sortBy = SortBy::Name,
-	    bool reverseSort = false,
-	    bool jsonOutput = false
-	) {
+	void SearchExtensions(std::string_view query) {
 		if (!CheckManager()) {
 			return;
 		}
 
 		const auto& manager = s_plugify->GetManager();
-		auto modules = manager.GetExtensionsByType(ExtensionType::Module);
+		auto allExtensions = manager.GetExtensions();
 
-		// Apply filters
-		auto filtered = FilterExtensions(modules, filter);
-		SortExtensions(filtered, sortBy, reverseSort);
+		auto* resource = CommandArena::Get();
+		std::pmr::vector<const Extension*> matches(resource);
+		auto lowerQuery = ToLower(query, resource);
 
-		// Output
-		if (jsonOutput) {
-			glz::json_t::array_t objects;
-			objects.reserve(filtered.size());
-			for (const auto& module : filtered) {
-				objects.emplace_back(ExtensionToJson(module));
+		for (const auto& ext : allExtensions) {
+			auto name = ToLower(ext->GetName(), resource);
+			auto desc = ToLower(ext->GetDescription(), resource);
+			auto author = ToLower(ext->GetAuthor(), resource);
+
+			if (name.find(lowerQuery) != std::string::npos || desc.find(lowerQuery) != std::string::npos
+			    || author.find(lowerQuery) != std::string::npos) {
+				matches.push_back(ext);
 			}
-			plg::print(*glz::json_t{ std::move(objects) }.dump());
-			return;
 		}
 
-		auto count = filtered.size();
-		if (!count) {
-			plg::print(Colorize("No modules found matching criteria.", Colors::YELLOW));
+		if (matches.empty()) {
+			plg::print(
+			    "{} No extensions found matching '{}'",
+			    Colorize(Icons.Missing, Colors::YELLOW),
+			    query
+			);
 			return;
 		}
 
 		plg::print(
-		    "{}:",
-		    Colorize(std::format("Listing {} module{}", count, (count > 1) ? "s" : ""), Colors::ORANGE)
-		);
-		plg::print(SEPARATOR_LINE);
-
-		// Header
-		plg::print(
-		    "{} {} {} {} {} {}",
-		    Colorize(std::format("{:<3}", Icons.Number), Colors::GRAY),
-		    Colorize(std::format("{:<25}", "Name"), Colors::GRAY),
-		    Colorize(std::format("{:<15}", "Version"), Colors::GRAY),
-		    Colorize(std::format("{:<12}", "State"), Colors::GRAY),
-		    Colorize(std::format("{:<8}", "Lang"), Colors::GRAY),
-		    Colorize(std::format("{:<12}", "Load Time"), Colors::GRAY)
+		    "{}: Found {} match{} for '{}'",
+		    Colorize("SEARCH RESULTS", Colors::ORANGE),
+		    matches.size(),
+		    matches.size() > 1 ? "es" : "",
+		    query
 		);
 		plg::print(SEPARATOR_LINE);
 
-		size_t index = 1;
-		for (const auto& module : filtered) {
-			auto state = module->GetState();
-			auto stateStr = plg::enum_to_string(state);
-			auto [symbol, color] = GetStateInfo(state);
-
-			// Get load time if available
-			std::string loadTime = "N/A";
-			try {
-				auto duration = module->GetOperationTime(ExtensionState::Loaded);
-				if (duration.count() > 0) {
-					loadTime = FormatDuration(duration);
-				}
-			} catch (...) {
-			}
-
+		for (const auto& ext : matches) {
+			auto [symbol, color] = GetStateInfo(ext->GetState());
 			plg::print(
-			    "{:<3} {:<25} {:<15} {} {:<11} {:<8} {:<12}",
-			    index++,
-			    Truncate(module->GetName(), 24),
-			    module->GetVersionString(),
+			    "{} {} {} {} {}",
 			    Colorize(symbol, color),
-			    Truncate(std::string(stateStr), 10),
-			    Truncate(module->GetLanguage(), 7),
-			    loadTime
+			    Colorize(ext->GetName(), Colors::ORANGE),
+			    Colorize(ext->GetVersionString(), Colors::GRAY),
+			    ext->IsPlugin() ? "[Plugin]" : "[Module]",
+			    Colorize(std::format("({})", ext->GetLanguage()), Colors::GRAY)
 			);
 
-			// Show errors/warnings if any
-			if (module->HasErrors()) {
-				for (const auto& error : module->GetErrors()) {
-					plg::print("     └─ {}: {}", Colorize("Error", Colors::RED), error);
-				}
-			}
-			if (module->HasWarnings()) {
-				for (const auto& warning : module->GetWarnings()) {
-					plg::print("     └─ {}: {}", Colorize("Warning", Colors::YELLOW), warning);
-				}
+			if (!ext->GetDescription().empty()) {
+				plg::print("  {}", Truncate(ext->GetDescription(), 70));
 			}
 		}
 		plg::print(SEPARATOR_LINE);
-
-		// Summary
-		if (filter.states.has_value() || filter.languages.has_value()
-		    || filter.searchQuery.has_value() || filter.showOnlyFailed) {
-			plg::print(
-			    "{}",
-			    Colorize(
-			        std::format("Filtered: {} of {} total modules shown", filtered.size(), modules.size()),
-			        Colors::GRAY
-			    )
-			);
-		}
 	}
 
-	void ShowPlugin(std::string_view identifier, bool plugin_use_id, bool jsonOutput) {
-		if (!CheckManager()) {
-			return;
-		}
+	struct ValidationReport {
+		fs::path path;
+		bool exists = false;
+		bool isPlugin = false;
+		bool isModule = false;
+		std::string fileExt;
+		std::string fileSize;
+	};
 
-		const auto& manager = s_plugify->GetManager();
-		auto plugin = plugin_use_id ? manager.FindExtension(FormatId(identifier))
-		                            : manager.FindExtension(identifier);
+	// Touches the filesystem only, so it can run on the task pool
+	ValidationReport InspectExtensionFile(const fs::path& path) {
+		ValidationReport report{ .path = path };
 
-		if (!plugin) {
-			if (jsonOutput) {
-				glz::json_t error;
-				error["error"] = std::format("Plugin {} not found", identifier);
-				plg::print(*error.dump());
-			} else {
-				plg::print("{}: Plugin {} not found.", Colorize("Error", Colors::RED), identifier);
-			}
-			return;
+		// Check if file exists
+		std::error_code ec;
+		report.exists = fs::exists(path, ec);
+		if (!report.exists) {
+			return report;
 		}
 
-		if (!plugin->IsPlugin()) {
-			if (jsonOutput) {
-				glz::json_t error;
-				error["error"] = std::format("'{}' is not a plugin (it's a module)", identifier);
-				plg::print(*error.dump());
-			} else {
-				plg::print(
-				    "{}: '{}' is not a plugin (it's a module).",
-				    Colorize("Error", Colors::RED),
-				    identifier
-				);
-			}
+		// Check file extension
+		report.fileExt = plg::as_string(path.extension());
+		report.isPlugin = (report.fileExt == ".plg" || report.fileExt == ".pplugin");
+		report.isModule = (report.fileExt == ".mod" || report.fileExt == ".pmodule");
+		if (report.isPlugin || report.isModule) {
+			report.fileSize = FormatFileSize(path);
+		}
+		return report;
+	}
+
+	void PrintValidation(const ValidationReport& report) {
+		plg::print("{}: {}", Colorize("VALIDATING", Colors::ORANGE), plg::as_string(report.path));
+		plg::print(SEPARATOR_LINE);
+
+		if (!report.exists) {
+			plg::print("{} File does not exist", Colorize("✗", Colors::RED));
 			return;
 		}
 
-		// JSON output
-		if (jsonOutput) {
-			plg::print(*ExtensionToJson(plugin).dump());
+		if (!report.isPlugin && !report.isModule) {
+			plg::print("{} Invalid file extension: {}", Colorize("✗", Colors::RED), report.fileExt);
 			return;
 		}
 
-		// Display detailed plugin information with colors
-		plg::print(DOUBLE_LINE);
+		plg::print("{} File exists", Colorize(Icons.Ok, Colors::GREEN));
 		plg::print(
-		    "{}: {}",
-		    Colorize("PLUGIN INFORMATION", Colors::ORANGE),
-		    Colorize(plugin->GetName(), Colors::CYAN)
+		    "{} Valid extension type: {}",
+		    Colorize(Icons.Ok, Colors::GREEN),
+		    report.isPlugin ? "Plugin" : "Module"
 		);
-		plg::print(DOUBLE_LINE);
+		plg::print("{} File size: {}", Colorize(Icons.Missing, Colors::CYAN), report.fileSize);
 
-		// Status indicator
-		auto [symbol, stateColor] = GetStateInfo(plugin->GetState());
-		plg::print(
-		    "\n{} {} {}",
-		    Colorize(symbol, stateColor),
-		    Colorize("Status:", Colors::ORANGE),
-		    Colorize(plg::enum_to_string(plugin->GetState()), stateColor)
-		);
+		// Try to parse manifest (you'd need to implement manifest parsing)
+		// This is a placeholder for actual validation logic
+		/*plg::print("{} Manifest validation: {}",
+		            Colorize(Icons.Missing, Colors::CYAN),
+		            "Would parse and validate manifest here");*/
+		// TODO
 
-		// Basic Information
-		plg::print(Colorize("\n[Basic Information]", Colors::CYAN));
-		plg::print("  {:<15} {}", Colorize("ID:", Colors::GRAY), plugin->GetId());
-		plg::print("  {:<15} {}", Colorize("Name:", Colors::GRAY), plugin->GetName());
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("Version:", Colors::GRAY),
-		    Colorize(plugin->GetVersionString(), Colors::GREEN)
-		);
-		plg::print("  {:<15} {}", Colorize("Language:", Colors::GRAY), plugin->GetLanguage());
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("Location:", Colors::GRAY),
-		    plg::as_string(plugin->GetLocation())
-		);
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("File Size:", Colors::GRAY),
-		    FormatFileSize(plugin->GetLocation())
+		plg::print(SEPARATOR_LINE);
+		plg::print("{}: Validation complete", Colorize("RESULT", Colors::ORANGE));
+	}
+
+	// The report is printed from the game thread once the pool has inspected the file
+	void ValidateExtension(const fs::path& path) {
+		TaskPool::Run(
+		    [path] { return InspectExtensionFile(path); },
+		    [](ValidationReport report) { PrintValidation(report); }
 		);
+	}
 
-		// Optional Information
-		if (!plugin->GetDescription().empty() || !plugin->GetAuthor().empty()
-		    || !plugin->GetWebsite().empty() || !plugin->GetLicense().empty()) {
-			plg::print(Colorize("\n[Additional Information]", Colors::CYAN));
-			if (!plugin->GetDescription().empty()) {
-				plg::print(
-				    "  {:<15} {}",
-				    Colorize("Description:", Colors::GRAY),
-				    plugin->GetDescription()
-				);
-			}
-			if (!plugin->GetAuthor().empty()) {
-				plg::print(
-				    "  {:<15} {}",
-				    Colorize("Author:", Colors::GRAY),
-				    Colorize(plugin->GetAuthor(), Colors::MAGENTA)
-				);
-			}
-			if (!plugin->GetWebsite().empty()) {
-				plg::print(
-				    "  {:<15} {}",
-				    Colorize("Website:", Colors::GRAY),
-				    Colorize(plugin->GetWebsite(), Colors::BLUE)
-				);
-			}
-			if (!plugin->GetLicense().empty()) {
-				plg::print("  {:<15} {}", Colorize("License:", Colors::GRAY), plugin->GetLicense());
-			}
+	// 'plugify perf --arena': scratch arena usage of the previous plugify command on this thread.
+	// Only allocations routed through CommandArena are counted; "overflow blocks" are the extra
+	// blocks it took from the heap once the first one was used up, not every heap allocation the
+	// command made.
+	void ShowArenaUsage(bool jsonOutput) {
+		auto usage = CommandArena::Last();
+		if (jsonOutput) {
+			glz::json_t j;
+			j["allocations"] = static_cast<double>(usage.allocations);
+			j["bytes"] = static_cast<double>(usage.bytes);
+			j["overflow_blocks"] = static_cast<double>(usage.heapAllocations);
+			j["block_size"] = static_cast<double>(CommandArena::kBlockSize);
+			plg::print(*j.dump());
+			return;
 		}
 
-		// Plugin-specific information
-		if (!plugin->GetEntry().empty()) {
-			plg::print(Colorize("\n[Plugin Details]", Colors::CYAN));
-			plg::print(
-			    "  {:<15} {}",
-			    Colorize("Entry Point:", Colors::GRAY),
-			    Colorize(plugin->GetEntry(), Colors::YELLOW)
-			);
+		plg::print(Colorize("COMMAND ARENA", Colors::ORANGE));
+		plg::print(SEPARATOR_LINE);
+		plg::print("  Allocations:      {} (previous command)", usage.allocations);
+		plg::print("  Bytes:            {}", usage.bytes);
+		plg::print("  Overflow blocks:  {} beyond the {} KiB block", usage.heapAllocations, CommandArena::kBlockSize / 1024);
+		plg::print(SEPARATOR_LINE);
+	}
+
+	void ShowTaskPool(bool jsonOutput) {
+		auto stats = TaskPool::GetStats();
+		const auto& options = TaskPool::GetOptions();
+
+		if (jsonOutput) {
+			glz::json_t j;
+			j["workers"] = stats.workers;
+			j["queued"] = stats.queued;
+			j["continuations"] = stats.continuations;
+			j["executed"] = stats.executed;
+			j["stolen"] = stats.stolen;
+			j["drained"] = stats.drained;
+			j["budget_us"] = options.budget.count();
+			glz::json_t::array_t affinity;
+			for (auto cpu : options.affinity) {
+				affinity.emplace_back(static_cast<double>(cpu));
+			}
+			j["affinity"] = std::move(affinity);
+			plg::print(*j.dump());
+			return;
 		}
 
-		// Methods
-		const auto& methods = plugin->GetMethods();
-		if (!methods.empty()) {
-			plg::print(
-			    Colorize("\n[Exported Methods]", Colors::CYAN)
-			    + Colorize(std::format(" ({} total)", methods.size()), Colors::GRAY)
-			);
+		plg::print(
+		    "{}: {}",
+		    Colorize("TASK POOL", Colors::ORANGE),
+		    TaskPool::IsRunning() ? Colorize(std::format("{} workers", stats.workers), Colors::GREEN)
+		                          : Colorize("stopped", Colors::GRAY)
+		);
+		plg::print(SEPARATOR_LINE);
+		plg::print("  Queued tasks:     {}", stats.queued);
+		plg::print("  Executed:         {} ({} stolen)", stats.executed, stats.stolen);
+		plg::print("  Continuations:    {} pending, {} drained", stats.continuations, stats.drained);
+		plg::print("  Tick budget:      {}", FormatDuration(options.budget));
+		std::string affinity;
+		for (auto cpu : options.affinity) {
+			std::format_to(std::back_inserter(affinity), "{}{}", affinity.empty() ? "" : ",", cpu);
+		}
+		plg::print("  Affinity:         {}", affinity.empty() ? "any" : affinity);
+		plg::print(SEPARATOR_LINE);
+	}
 
-			size_t displayCount = std::min<size_t>(methods.size(), 10);
-			for (size_t i = 0; i < displayCount; ++i) {
-				const auto& method = methods[i];
-				plg::print(
-				    "  {}{:<2} {}",
-				    Colorize(Icons.Number, Colors::GRAY),
-				    i + 1,
-				    Colorize(method.GetName(), Colors::GREEN)
-				);
-				if (!method.GetFuncName().empty()) {
-					plg::print(
-					    "      {} {}",
-					    Colorize("Func Name:", Colors::GRAY),
-					    method.GetFuncName()
-					);
-				}
+	// Built-in host qualification suite ('plugify bench'). CPU kernels run on their own thread so
+	// the server keeps ticking. The launcher's own per-tick section is timed across real ticks and
+	// extension snapshot queries are spread over ticks in slices of at most kSliceBudget.
+	class HostBench {
+	public:
+		struct Metric {
+			std::string name;
+			std::string unit;
+			double value{};
+			uint64_t samples{};
+		};
+
+		static bool Start(bool quick, bool jsonOutput) {
+			if (_running) {
+				return false;
 			}
-			if (methods.size() > 10) {
-				plg::print(
-				    "  {} ... and {} more methods",
-				    Colorize(Icons.Arrow, Colors::GRAY),
-				    methods.size() - 10
-				);
+			_running = true;
+			_json = jsonOutput;
+			_metrics.clear();
+			_tickTarget = quick ? 200 : 2000;
+			_queryTarget = quick ? 100 : 1000;
+			_ticks.clear();
+			_queries.clear();
+			_mainPhase = false;
+
+			fs::path logPath = fs::path(Plat_GetGameDirectory()) / BASE_PATH / "logs" / FormatFileName("bench", "log");
+			auto kernelTime = quick ? std::chrono::milliseconds(100) : std::chrono::milliseconds(1000);
+			size_t logMessages = quick ? 10000 : 100000;
+			if (_worker.joinable()) {
+				_worker.join();
 			}
+			_worker = std::jthread([logPath, kernelTime, logMessages] {
+				auto metrics = RunKernels(logPath, kernelTime, logMessages);
+				TaskPool::PostMain([metrics = std::move(metrics)]() mutable {
+					std::move(metrics.begin(), metrics.end(), std::back_inserter(_metrics));
+					_mainPhase = true;
+				});
+			});
+			return true;
 		}
 
-		// Platforms
-		const auto& platforms = plugin->GetPlatforms();
-		if (!platforms.empty()) {
-			plg::print(Colorize("\n[Supported Platforms]", Colors::CYAN));
-			plg::print("  {}", Colorize(plg::join(platforms, ", "), Colors::GREEN));
+		static bool IsRunning() {
+			return _running;
 		}
 
-		// Dependencies
-		const auto& deps = plugin->GetDependencies();
-		if (!deps.empty()) {
-			plg::print(
-			    Colorize("\n[Dependencies]", Colors::CYAN)
-			    + Colorize(std::format(" ({} total)", deps.size()), Colors::GRAY)
-			);
-			for (const auto& dep : deps) {
-				std::string depIndicator = dep.IsOptional() ? Colorize(Icons.Skipped, Colors::GRAY)
-				                                            : Colorize(Icons.Valid, Colors::GREEN);
-				plg::print(
-				    "  {} {} {}",
-				    depIndicator,
-				    Colorize(dep.GetName(), Colors::ORANGE),
-				    Colorize(dep.GetConstraints().to_string(), Colors::GRAY)
-				);
-				if (dep.IsOptional()) {
-					plg::print("    └─ {}", Colorize("Optional", Colors::GRAY));
+		// Game thread, at the end of the tick. 'launcher' is the time ServerGamePostSimulate spent in
+		// its own work after Update() (commands, continuations, replay, pager) on this tick.
+		// Update() itself is not benchmarked: on a live server it runs every plugin's frame callback.
+		static void Tick(std::chrono::nanoseconds launcher) {
+			if (!_running || !_mainPhase) {
+				return;
+			}
+			if (!s_plugify || !s_plugify->GetManager().IsInitialized()) {
+				plg::print("{}: Benchmark aborted, the plugin manager was unloaded.", Colorize("Error", Colors::RED));
+				_running = false;
+				return;
+			}
+
+			if (_ticks.size() < _tickTarget) {
+				_ticks.push_back(launcher.count());
+			}
+
+			using clock = std::chrono::steady_clock;
+			auto deadline = clock::now() + kSliceBudget;
+			const auto& manager = s_plugify->GetManager();
+			while (clock::now() < deadline) {
+				if (_queries.size() < _queryTarget) {
+					auto start = clock::now();
+					auto plugins = manager.GetExtensionsByType(ExtensionType::Plugin);
+					auto filtered = FilterExtensions(plugins, FilterOptions{});
+					SortExtensions(filtered, SortBy::Name);
+					glz::json_t::array_t objects;
+					objects.reserve(filtered.size());
+					for (const auto& plugin : filtered) {
+						objects.emplace_back(ExtensionToJson(plugin));
+					}
+					std::ignore = glz::json_t{ std::move(objects) }.dump();
+					_queries.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+				} else if (_ticks.size() >= _tickTarget) {
+					Finish();
+					return;
+				} else {
+					return;  // queries done, waiting for tick samples
 				}
 			}
 		}
 
-		// Conflicts
-		const auto& conflicts = plugin->GetConflicts();
-		if (!conflicts.empty()) {
-			plg::print(
-			    Colorize("\n[Conflicts]", Colors::YELLOW)
-			    + Colorize(std::format(" ({} total)", conflicts.size()), Colors::GRAY)
-			);
-			for (const auto& conflict : conflicts) {
-				plg::print(
-				    "  {} {} {}",
-				    Colorize(Icons.Warning, Colors::YELLOW),
-				    conflict.GetName(),
-				    Colorize(conflict.GetConstraints().to_string(), Colors::GRAY)
-				);
-				if (!conflict.GetReason().empty()) {
-					plg::print("    └─ {}", Colorize(conflict.GetReason(), Colors::RED));
-				}
+	private:
+		static constexpr auto kSliceBudget = std::chrono::milliseconds(2);
+
+		template <typename Op>
+		static std::pair<uint64_t, std::chrono::nanoseconds> Repeat(std::chrono::milliseconds minTime, Op&& op) {
+			using clock = std::chrono::steady_clock;
+			uint64_t iterations = 0;
+			auto start = clock::now();
+			auto elapsed = clock::duration{};
+			while (elapsed < minTime) {
+				op();
+				++iterations;
+				elapsed = clock::now() - start;
 			}
+			return { iterations, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) };
 		}
 
-		// Performance Information
-		plg::print(Colorize("\n[Performance Metrics]", Colors::CYAN));
-		auto totalTime = plugin->GetTotalTime();
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("Total Time:", Colors::GRAY),
-		    Colorize(
-		        FormatDuration(totalTime),
-		        totalTime > std::chrono::seconds(1) ? Colors::YELLOW : Colors::GREEN
-		    )
-		);
+		static double PerSecond(double count, std::chrono::nanoseconds elapsed) {
+			return elapsed.count() > 0 ? count * 1e9 / static_cast<double>(elapsed.count()) : 0.0;
+		}
 
-		// Show timing for different operations
-		ExtensionState operations[] = {
-			ExtensionState::Parsing,
-			ExtensionState::Resolving,
-			ExtensionState::Loading,
-			ExtensionState::Starting,
-		};
+		static std::vector<Metric> RunKernels(const fs::path& logPath, std::chrono::milliseconds minTime, size_t logMessages) {
+			std::vector<Metric> metrics;
 
-		for (const auto& op : operations) {
-			try {
-				auto duration = plugin->GetOperationTime(op);
-				if (duration.count() > 0) {
-					bool slow = duration > std::chrono::milliseconds(500);
-					plg::print(
-					    "  {:<15} {}",
-					    Colorize(std::format("{}:", plg::enum_to_string(op)), Colors::GRAY),
-					    Colorize(FormatDuration(duration), slow ? Colors::YELLOW : Colors::GREEN)
-					);
+			// Log enqueue into the async writer, then the time it takes to drain to disk. Capped by
+			// count: the writer queue is unbounded, a timed run would buffer whatever fits in memory.
+			if (auto writer = LogFileWriter::Create(logPath, true)) {
+				constexpr std::string_view message = "[bench] The quick brown fox jumps over the lazy dog 0123456789";
+				auto start = std::chrono::steady_clock::now();
+				for (size_t i = 0; i < logMessages; ++i) {
+					(*writer)->Append(message);
 				}
-			} catch (...) {
+				auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+				auto count = static_cast<uint64_t>(logMessages);
+				writer->reset();  // drains the queue
+				auto drained = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+				metrics.push_back({ "log enqueue", "msg/s", PerSecond(static_cast<double>(count), elapsed), count });
+				metrics.push_back({ "log enqueue+drain", "msg/s", PerSecond(static_cast<double>(count), drained), count });
+				std::error_code ec;
+				fs::remove(logPath, ec);
+			} else {
+				metrics.push_back({ "log enqueue", writer.error(), 0.0, 0 });
 			}
-		}
 
-		// Errors and Warnings
-		if (plugin->HasErrors() || plugin->HasWarnings()) {
-			plg::print(Colorize("\n[Issues]", Colors::RED));
-			for (const auto& error : plugin->GetErrors()) {
-				plg::print("  {} {}", Colorize("ERROR:", Colors::RED), error);
+			// Colored table output as produced by the list commands
+			std::string text;
+			for (size_t i = 0; i < 64; ++i) {
+				std::format_to(
+				    std::back_inserter(text),
+				    "{}{:<32}{} {:>10} {}\n",
+				    Colors::CYAN,
+				    std::format("extension_{}", i),
+				    Colors::RESET,
+				    i * 31,
+				    SEPARATOR_LINE
+				);
 			}
-			for (const auto& warning : plugin->GetWarnings()) {
-				plg::print("  {} {}", Colorize("WARNING:", Colors::YELLOW), warning);
+			{
+				auto [count, elapsed] = Repeat(minTime, [&] {
+					auto copy = text;
+					auto segments = AnsiColorParser::Tokenize(copy);
+					for (const auto& segment : segments) {
+						std::ignore = SplitConsoleChunks(segment.text);
+					}
+				});
+				metrics.push_back({ "console tokenizer", "MB/s", PerSecond(static_cast<double>(count * text.size()), elapsed) / 1e6, count });
 			}
-		} else {
-			plg::print(
-			    "\n{} {}",
-			    Colorize(Icons.Ok, Colors::GREEN),
-			    Colorize("No issues detected", Colors::GREEN)
-			);
+			{
+				auto loc = std::source_location::current();
+				auto [count, elapsed] = Repeat(minTime, [&] {
+					std::ignore = FormatLogMessage("The quick brown fox jumps over the lazy dog", Severity::Info, loc);
+				});
+				metrics.push_back({ "log format", "msg/s", PerSecond(static_cast<double>(count), elapsed), count });
+			}
+
+			return metrics;
 		}
 
-		plg::print(DOUBLE_LINE);
+		static int64_t Percentile(std::vector<int64_t>& values, double p) {
+			if (values.empty()) {
+				return 0;
+			}
+			auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+			std::nth_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(index), values.end());
+			return values[index];
+		}
+
+		static void Finish() {
+			_running = false;
+
+			auto addLatency = [](std::string name, std::vector<int64_t>& values) {
+				auto samples = static_cast<uint64_t>(values.size());
+				_metrics.push_back({ name + " p50", "us", static_cast<double>(Percentile(values, 0.50)) / 1000.0, samples });
+				_metrics.push_back({ name + " p99", "us", static_cast<double>(Percentile(values, 0.99)) / 1000.0, samples });
+			};
+			addLatency("launcher tick", _ticks);
+			addLatency("snapshot query", _queries);
+
+			if (_json) {
+				glz::json_t::array_t results;
+				for (const auto& metric : _metrics) {
+					glz::json_t j;
+					j["name"] = metric.name;
+					j["unit"] = metric.unit;
+					j["value"] = metric.value;
+					j["samples"] = static_cast<double>(metric.samples);
+					results.emplace_back(std::move(j));
+				}
+				glz::json_t j;
+				j["version"] = S2_PROJECT_VERSION;
+				j["threads"] = static_cast<double>(std::thread::hardware_concurrency());
+				j["results"] = glz::json_t::array_t{ std::move(results) };
+				plg::print(*j.dump());
+				return;
+			}
+
+			plg::print(Colorize("Host Benchmark:", Colors::CYAN));
+			plg::print(SEPARATOR_LINE);
+			plg::print("{:<28} {:>16} {:<8} {:>12}", "Metric", "Value", "Unit", "Samples");
+			plg::print(SEPARATOR_LINE);
+			for (const auto& metric : _metrics) {
+				plg::print("{:<28} {:>16.2f} {:<8} {:>12}", metric.name, metric.value, metric.unit, metric.samples);
+			}
+			plg::print(SEPARATOR_LINE);
+			plg::print("  Hardware threads: {}", std::thread::hardware_concurrency());
+		}
+
+		inline static std::jthread _worker;
+		inline static std::vector<Metric> _metrics;
+		inline static std::vector<int64_t> _ticks;
+		inline static std::vector<int64_t> _queries;
+		inline static size_t _tickTarget{};
+		inline static size_t _queryTarget{};
+		inline static bool _mainPhase{ false };
+		inline static bool _running{ false };
+		inline static bool _json{ false };
+	};
+
+	void StartHostBench(bool quick, bool jsonOutput) {
+		if (!CheckManager()) {
+			return;
+		}
+		if (!HostBench::Start(quick, jsonOutput)) {
+			plg::print("{}: A benchmark is already running.", Colorize("Error", Colors::RED));
+			return;
+		}
+		plg::print(
+		    "{}: Running {} benchmark in the background, results follow when it completes.",
+		    Colorize("Info", Colors::BLUE),
+		    quick ? "quick" : "full"
+		);
 	}
 
-	void ShowModule(std::string_view identifier, bool module_use_id, bool jsonOutput) {
+	void CompareExtensions(std::string_view name1, std::string_view name2, bool useId = false) {
 		if (!CheckManager()) {
 			return;
 		}
 
 		const auto& manager = s_plugify->GetManager();
-		auto module = module_use_id ? manager.FindExtension(FormatId(identifier))
-		                            : manager.FindExtension(identifier);
+		auto ext1 = useId ? manager.FindExtension(FormatId(name1)) : manager.FindExtension(name1);
+		auto ext2 = useId ? manager.FindExtension(FormatId(name2)) : manager.FindExtension(name2);
 
-		if (!module) {
-			if (jsonOutput) {
-				glz::json_t error;
-				error["error"] = std::format("Module {} not found", identifier);
-				plg::print(*error.dump());
-			} else {
-				plg::print("{}: Module {} not found.", Colorize("Error", Colors::RED), identifier);
-			}
+		if (!ext1) {
+			plg::print("{}: Extension {} not found.", Colorize("Error", Colors::RED), name1);
 			return;
 		}
-
-		if (!module->IsModule()) {
-			if (jsonOutput) {
-				glz::json_t error;
-				error["error"] = std::format("'{}' is not a module (it's a plugin)", identifier);
-				plg::print(*error.dump());
-			} else {
-				plg::print(
-				    "{}: '{}' is not a module (it's a plugin).",
-				    Colorize("Error", Colors::RED),
-				    identifier
-				);
-			}
+		if (!ext2) {
+			plg::print("{}: Extension {} not found.", Colorize("Error", Colors::RED), name2);
 			return;
 		}
 
-		// JSON output
-		if (jsonOutput) {
-			plg::print(*ExtensionToJson(module).dump());
-			return;
-		}
+		ReportBuffer report;
+		report.Line(DOUBLE_LINE);
+		report.Line("EXTENSION COMPARISON", Colors::ORANGE);
+		report.Line(DOUBLE_LINE);
+		report.Line();
 
-		// Display detailed module information with colors
-		plg::print(DOUBLE_LINE);
-		plg::print(
-		    "{}: {}",
-		    Colorize("MODULE INFORMATION", Colors::ORANGE),
-		    Colorize(module->GetName(), Colors::MAGENTA)
-		);
-		plg::print(DOUBLE_LINE);
+		// Basic comparison table
+		Table table{
+			{ "", 20 },
+			{ ext1->GetName(), 25, Colors::CYAN },
+			{ "" },
+			{ ext2->GetName(), 25, Colors::MAGENTA },
+		};
+		auto addRow = [&table](std::string_view label, std::string_view val1, std::string_view val2) {
+			bool same = (val1 == val2);
+			table.Cell(label).Cell(val1).Cell(same ? Icons.Equal : Icons.NotEqual).Cell(val2);
+		};
 
-		// Status indicator
-		auto [symbol, stateColor] = GetStateInfo(module->GetState());
-		plg::print(
-		    "\n{} {} {}",
-		    Colorize(symbol, stateColor),
-		    Colorize("Status:", Colors::ORANGE),
-		    Colorize(plg::enum_to_string(module->GetState()), stateColor)
-		);
+		addRow("Type:", ext1->IsPlugin() ? "Plugin" : "Module", ext2->IsPlugin() ? "Plugin" : "Module");
+		addRow("Version:", ext1->GetVersionString(), ext2->GetVersionString());
+		addRow("Language:", ext1->GetLanguage(), ext2->GetLanguage());
+		addRow("State:", plg::enum_to_string(ext1->GetState()), plg::enum_to_string(ext2->GetState()));
+		addRow("Author:", ext1->GetAuthor(), ext2->GetAuthor());
+		addRow("License:", ext1->GetLicense(), ext2->GetLicense());
+		table.Render(report, SEPARATOR_LINE);
 
-		// Basic Information
-		plg::print(Colorize("\n[Basic Information]", Colors::CYAN));
-		plg::print("  {:<15} {}", Colorize("ID:", Colors::GRAY), module->GetId());
-		plg::print("  {:<15} {}", Colorize("Name:", Colors::GRAY), module->GetName());
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("Version:", Colors::GRAY),
-		    Colorize(module->GetVersionString(), Colors::GREEN)
+		// Dependencies comparison
+		report.Line().Line("[Dependencies]", Colors::ORANGE);
+		const auto& deps1 = ext1->GetDependencies();
+		const auto& deps2 = ext2->GetDependencies();
+
+		auto* resource = CommandArena::Get();
+		std::pmr::set<std::pmr::string> depNames1(resource), depNames2(resource);
+		for (const auto& d : deps1) {
+			depNames1.emplace(d.GetName());
+		}
+		for (const auto& d : deps2) {
+			depNames2.emplace(d.GetName());
+		}
+
+		std::pmr::vector<std::pmr::string> onlyIn1(resource), onlyIn2(resource), common(resource);
+		std::set_difference(
+		    depNames1.begin(),
+		    depNames1.end(),
+		    depNames2.begin(),
+		    depNames2.end(),
+		    std::back_inserter(onlyIn1)
 		);
-		plg::print("  {:<15} {}", Colorize("Language:", Colors::GRAY), module->GetLanguage());
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("Location:", Colors::GRAY),
-		    plg::as_string(module->GetLocation())
+		std::set_difference(
+		    depNames2.begin(),
+		    depNames2.end(),
+		    depNames1.begin(),
+		    depNames1.end(),
+		    std::back_inserter(onlyIn2)
 		);
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("File Size:", Colors::GRAY),
-		    FormatFileSize(module->GetLocation())
+		std::set_intersection(
+		    depNames1.begin(),
+		    depNames1.end(),
+		    depNames2.begin(),
+		    depNames2.end(),
+		    std::back_inserter(common)
 		);
 
-		// Optional Information
-		if (!module->GetDescription().empty() || !module->GetAuthor().empty()
-		    || !module->GetWebsite().empty() || !module->GetLicense().empty()) {
-			plg::print(Colorize("\n[Additional Information]", Colors::CYAN));
-			if (!module->GetDescription().empty()) {
-				plg::print(
-				    "  {:<15} {}",
-				    Colorize("Description:", Colors::GRAY),
-				    module->GetDescription()
-				);
-			}
-			if (!module->GetAuthor().empty()) {
-				plg::print(
-				    "  {:<15} {}",
-				    Colorize("Author:", Colors::GRAY),
-				    Colorize(module->GetAuthor(), Colors::MAGENTA)
-				);
+		auto appendNames = [&report](const std::pmr::vector<std::pmr::string>& names) {
+			for (size_t i = 0; i < names.size(); ++i) {
+				report.Append(i ? ", " : "").Append(names[i]);
 			}
-			if (!module->GetWebsite().empty()) {
-				plg::print(
-				    "  {:<15} {}",
-				    Colorize("Website:", Colors::GRAY),
-				    Colorize(module->GetWebsite(), Colors::BLUE)
+			report.Line();
+		};
+		if (!common.empty()) {
+			report.Append("  Common: ");
+			appendNames(common);
+		}
+		if (!onlyIn1.empty()) {
+			report.Format("  Only in {}: ", ext1->GetName());
+			appendNames(onlyIn1);
+		}
+		if (!onlyIn2.empty()) {
+			report.Format("  Only in {}: ", ext2->GetName());
+			appendNames(onlyIn2);
+		}
+
+		// Performance comparison
+		report.Line().Line("[Performance]", Colors::ORANGE);
+		report.Append("  Load Time:     ").Pad(FormatDuration(ext1->GetOperationTime(ExtensionState::Loaded)), 15);
+		report.Append(" vs ").Line(FormatDuration(ext2->GetOperationTime(ExtensionState::Loaded)));
+		report.Append("  Total Time:    ").Pad(FormatDuration(ext1->GetTotalTime()), 15);
+		report.Append(" vs ").Line(FormatDuration(ext2->GetTotalTime()));
+
+		report.Line(DOUBLE_LINE);
+		plg::print(report.Take());
+	}
+};
+
+// Background micromamba jobs. Each job owns its process on a dedicated thread and streams
+// output line by line to the console through game-thread continuations, so package
+// operations never block a tick. Jobs are cancelled through their stop token.
+class MambaJobs {
+public:
+	enum class JobState : uint8_t {
+		Running,
+		Succeeded,
+		Failed,
+		Cancelled,
+		TimedOut,
+	};
+
+	struct JobInfo {
+		uint64_t id;
+		std::string command;
+		JobState state;
+		int exitCode;
+		std::chrono::milliseconds elapsed;
+	};
+
+	static constexpr std::chrono::seconds kDefaultTimeout{ 1800 };
+
+	struct Options {
+		std::chrono::seconds timeout = kDefaultTimeout;  // 0 waits forever
+		// Runs on the job thread before micromamba starts. Its presence marks the job as
+		// writing a staged environment, which blocks 'plugify swap'.
+		std::move_only_function<Result<void>()> prepare;
+		// Receives the stdout lines of a successful run, on the job thread
+		std::move_only_function<void(std::vector<std::string>)> capture;
+		// Runs on the job thread after micromamba succeeded, a failure fails the job
+		std::move_only_function<Result<void>()> complete;
+		// Environment the job writes to, empty for read-only commands. Claimed in MambaWriters
+		// for the lifetime of the job.
+		fs::path prefix;
+	};
+
+	static Result<uint64_t> Launch(std::vector<std::string> cmd, std::string label, Options options) {
+		std::scoped_lock lock(_mutex);
+		Prune();
+
+		auto id = _nextId;
+		if (!options.prefix.empty()) {
+			if (auto owner = MambaWriters::Claim(id, options.prefix)) {
+				return MakeError(
+				    "micromamba job #{} is still writing {}, wait for it or run 'mamba cancel {}'.",
+				    *owner,
+				    plg::as_string(options.prefix),
+				    *owner
 				);
 			}
-			if (!module->GetLicense().empty()) {
-				plg::print("  {:<15} {}", Colorize("License:", Colors::GRAY), module->GetLicense());
-			}
 		}
+		++_nextId;
 
-		// Module-specific information
-		if (!module->GetRuntime().empty()) {
-			plg::print(Colorize("\n[Module Details]", Colors::CYAN));
-			plg::print(
-			    "  {:<15} {}",
-			    Colorize("Runtime:", Colors::GRAY),
-			    Colorize(plg::as_string(module->GetRuntime()), Colors::YELLOW)
-			);
+		auto job = std::make_unique<Job>();
+		job->id = id;
+		job->command = std::move(label);
+		job->start = std::chrono::steady_clock::now();
+		job->staged = static_cast<bool>(options.prepare);
+		if (job->staged) {
+			s_stagingJobs.fetch_add(1, std::memory_order_acq_rel);
 		}
+		job->thread = std::jthread(&MambaJobs::Run, job.get(), std::move(cmd), std::move(options));
+		_jobs.emplace(id, std::move(job));
+		return id;
+	}
 
-		// Directories
-		const auto& dirs = module->GetDirectories();
-		if (!dirs.empty()) {
-			plg::print(
-			    Colorize("\n[Search Directories]", Colors::CYAN)
-			    + Colorize(std::format(" ({} total)", dirs.size()), Colors::GRAY)
-			);
+	static bool Cancel(uint64_t id) {
+		std::scoped_lock lock(_mutex);
+		auto it = _jobs.find(id);
+		if (it == _jobs.end() || it->second->state.load(std::memory_order_acquire) != JobState::Running) {
+			return false;
+		}
+		return it->second->thread.request_stop();
+	}
 
-			size_t displayCount = std::min<size_t>(dirs.size(), 5);
-			for (size_t i = 0; i < displayCount; ++i) {
-				std::error_code ec;
-				bool exists = fs::exists(dirs[i], ec);
-				plg::print(
-				    "  {} {}",
-				    exists ? Colorize(Icons.Ok, Colors::GREEN) : Colorize(Icons.Fail, Colors::RED),
-				    plg::as_string(dirs[i])
-				);
-			}
-			if (dirs.size() > 5) {
-				plg::print(
-				    "  {} ... and {} more directories",
-				    Colorize(Icons.Arrow, Colors::GRAY),
-				    dirs.size() - 5
-				);
+	static std::vector<JobInfo> List() {
+		std::scoped_lock lock(_mutex);
+		std::vector<JobInfo> jobs;
+		jobs.reserve(_jobs.size());
+		auto now = std::chrono::steady_clock::now();
+		for (const auto& [id, job] : _jobs) {
+			auto state = job->state.load(std::memory_order_acquire);
+			auto end = state == JobState::Running ? now : job->end;
+			jobs.push_back({
+			    .id = id,
+			    .command = job->command,
+			    .state = state,
+			    .exitCode = job->exitCode,
+			    .elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - job->start),
+			});
+		}
+		return jobs;
+	}
+
+	// Cancels and joins every job
+	static void Shutdown() {
+		std::map<uint64_t, std::unique_ptr<Job>> jobs;
+		{
+			std::scoped_lock lock(_mutex);
+			jobs.swap(_jobs);
+		}
+		for (auto& [id, job] : jobs) {
+			job->thread.request_stop();
+		}
+		jobs.clear();
+	}
+
+private:
+	struct Job {
+		uint64_t id;
+		std::string command;
+		std::chrono::steady_clock::time_point start;
+		std::chrono::steady_clock::time_point end;
+		std::atomic<JobState> state{ JobState::Running };
+		int exitCode = -1;
+		bool staged = false;
+		std::jthread thread;
+	};
+
+	static void Post(uint64_t id, std::string line, ColorCode color = Colors::WHITE) {
+		TaskPool::PostMain([id, line = std::move(line), color] {
+			plg::print("{} {}", Colorize(std::format("[mamba #{}]", id), Colors::GRAY), Colorize(line, color));
+		});
+	}
+
+	// Splits a chunk into lines, keeping the unterminated tail for the next read
+	static void Stream(uint64_t id, std::string& pending, std::string_view chunk, std::vector<std::string>* captured) {
+		pending.append(chunk);
+		size_t begin = 0;
+		for (size_t end; (end = pending.find_first_of("\r\n", begin)) != std::string::npos; begin = end + 1) {
+			if (end > begin) {
+				auto line = pending.substr(begin, end - begin);
+				if (captured) {
+					captured->push_back(line);
+				}
+				Post(id, std::move(line));
 			}
 		}
+		pending.erase(0, begin);
+	}
 
-		// Assembly Information
-		if (auto assembly = module->GetAssembly()) {
-			plg::print(Colorize("\n[Assembly Information]", Colors::CYAN));
-			plg::print("  {} Assembly loaded and active", Colorize(Icons.Ok, Colors::GREEN));
-			// Add more assembly details if available in your IAssembly interface
+	static void Finish(Job* job, JobState state, int exitCode, std::string message) {
+		job->exitCode = exitCode;
+		job->end = std::chrono::steady_clock::now();
+		job->state.store(state, std::memory_order_release);
+		if (job->staged) {
+			s_stagingJobs.fetch_sub(1, std::memory_order_acq_rel);
 		}
+		MambaWriters::Release(job->id);
 
-		// Platforms
-		const auto& platforms = module->GetPlatforms();
-		if (!platforms.empty()) {
-			plg::print(Colorize("\n[Supported Platforms]", Colors::CYAN));
-			plg::print("  {}", Colorize(plg::join(platforms, ", "), Colors::GREEN));
+		ColorCode color = state == JobState::Succeeded ? Colors::GREEN
+		                  : state == JobState::Cancelled ? Colors::YELLOW
+		                                                 : Colors::RED;
+		Post(job->id, std::move(message), color);
+	}
+
+	static void Run(std::stop_token token, Job* job, std::vector<std::string> cmd, Options jobOptions) {
+		using namespace std::chrono;
+
+		if (jobOptions.prepare) {
+			if (auto result = jobOptions.prepare(); !result) {
+				Finish(job, JobState::Failed, -1, std::move(result.error()));
+				return;
+			}
 		}
 
-		// Dependencies
-		const auto& deps = module->GetDependencies();
-		if (!deps.empty()) {
-			plg::print(
-			    Colorize("\n[Dependencies]", Colors::CYAN)
-			    + Colorize(std::format(" ({} total)", deps.size()), Colors::GRAY)
-			);
-			for (const auto& dep : deps) {
-				std::string depIndicator = dep.IsOptional() ? Colorize(Icons.Skipped, Colors::GRAY)
-				                                            : Colorize(Icons.Valid, Colors::GREEN);
-				plg::print(
-				    "  {} {} {}",
-				    depIndicator,
-				    Colorize(dep.GetName(), Colors::ORANGE),
-				    Colorize(dep.GetConstraints().to_string(), Colors::GRAY)
-				);
-				if (dep.IsOptional()) {
-					plg::print("    └─ {}", Colorize("Optional", Colors::GRAY));
+		reproc::process process;
+		reproc::options options;
+		options.env.behavior = reproc::env::extend;
+
+		if (auto ec = process.start(cmd, options)) {
+			Finish(job, JobState::Failed, -1, std::format("Failed to start micromamba - {}", ec.message()));
+			return;
+		}
+
+		S2_PROBE2(mamba__start, process.pid().first, job->command.c_str());
+		Post(job->id, std::format("Started: {}", job->command), Colors::CYAN);
+
+		auto timeout = jobOptions.timeout;
+		auto deadline = timeout.count() > 0 ? job->start + timeout : steady_clock::time_point::max();
+		std::vector<std::string> captured;
+		auto* capture = jobOptions.capture ? &captured : nullptr;
+		std::string pendingOut, pendingErr;
+		std::array<uint8_t, 4096> buffer;
+		bool outOpen = true;
+		bool errOpen = true;
+		std::optional<JobState> interrupted;
+
+		while (outOpen || errOpen) {
+			if (token.stop_requested()) {
+				interrupted = JobState::Cancelled;
+				break;
+			}
+			if (steady_clock::now() >= deadline) {
+				interrupted = JobState::TimedOut;
+				break;
+			}
+
+			int interests = (outOpen ? reproc::event::out : 0) | (errOpen ? reproc::event::err : 0);
+			auto [events, ec] = process.poll(interests, milliseconds(100));
+			if (ec == std::errc::timed_out || (!ec && events == 0)) {
+				continue;
+			}
+			if (ec) {
+				Finish(job, JobState::Failed, -1, std::format("Failed to read output - {}", ec.message()));
+				process.stop({ { reproc::stop::terminate, milliseconds(2000) }, { reproc::stop::kill, reproc::infinite }, {} });
+				return;
+			}
+
+			auto drain = [&](reproc::stream stream, bool& open, std::string& pending, std::vector<std::string>* lines) {
+				auto [size, readEc] = process.read(stream, buffer.data(), buffer.size());
+				if (readEc) {
+					open = false;  // broken pipe once the child closes it
+					return;
 				}
+				Stream(job->id, pending, { reinterpret_cast<const char*>(buffer.data()), size }, lines);
+			};
+			if (events & reproc::event::out) {
+				drain(reproc::stream::out, outOpen, pendingOut, capture);
+			}
+			if (events & reproc::event::err) {
+				drain(reproc::stream::err, errOpen, pendingErr, nullptr);
 			}
 		}
 
-		// Conflicts
-		const auto& conflicts = module->GetConflicts();
-		if (!conflicts.empty()) {
-			plg::print(
-			    Colorize("\n[Conflicts]", Colors::YELLOW)
-			    + Colorize(std::format(" ({} total)", conflicts.size()), Colors::GRAY)
-			);
-			for (const auto& conflict : conflicts) {
-				plg::print(
-				    "  {} {} {}",
-				    Colorize(Icons.Warning, Colors::YELLOW),
-				    conflict.GetName(),
-				    Colorize(conflict.GetConstraints().to_string(), Colors::GRAY)
-				);
-				if (!conflict.GetReason().empty()) {
-					plg::print("    └─ {}", Colorize(conflict.GetReason(), Colors::RED));
-				}
+		if (capture && !pendingOut.empty()) {
+			captured.push_back(pendingOut);
+		}
+		for (auto* pending : { &pendingOut, &pendingErr }) {
+			if (!pending->empty()) {
+				Post(job->id, std::move(*pending));
 			}
 		}
 
-		// Performance Information
-		plg::print(Colorize("\n[Performance Metrics]", Colors::CYAN));
-		auto totalTime = module->GetTotalTime();
-		plg::print(
-		    "  {:<15} {}",
-		    Colorize("Total Time:", Colors::GRAY),
-		    Colorize(
-		        FormatDuration(totalTime),
-		        totalTime > std::chrono::seconds(1) ? Colors::YELLOW : Colors::GREEN
-		    )
-		);
-
-		// Show timing for different operations
-		ExtensionState operations[] = {
-			ExtensionState::Parsing,
-			ExtensionState::Resolving,
-			ExtensionState::Loading,
-			ExtensionState::Starting,
-		};
+		if (interrupted) {
+			auto [status, ec] = process.stop(
+			    { { reproc::stop::terminate, milliseconds(2000) }, { reproc::stop::kill, reproc::infinite }, {} }
+			);
+			S2_PROBE1(mamba__exit, ec ? -1 : status);
+			Finish(
+			    job,
+			    *interrupted,
+			    status,
+			    *interrupted == JobState::Cancelled ? "Cancelled."
+			                                        : std::format("Timed out after {}s.", timeout.count())
+			);
+			return;
+		}
 
-		for (const auto& op : operations) {
-			try {
-				auto duration = module->GetOperationTime(op);
-				if (duration.count() > 0) {
-					bool slow = duration > std::chrono::milliseconds(500);
-					plg::print(
-					    "  {:<15} {}",
-					    Colorize(std::format("{}:", plg::enum_to_string(op)), Colors::GRAY),
-					    Colorize(FormatDuration(duration), slow ? Colors::YELLOW : Colors::GREEN)
-					);
-				}
-			} catch (...) {
+		auto [status, ec] = process.wait(reproc::infinite);
+		S2_PROBE1(mamba__exit, ec ? -1 : status);
+		if (ec) {
+			Finish(job, JobState::Failed, -1, std::format("Process wait error - {}", ec.message()));
+		} else if (status != 0) {
+			Finish(job, JobState::Failed, status, std::format("Process exited with code - {}", status));
+		} else if (auto completed = jobOptions.complete ? jobOptions.complete() : Result<void>{}; !completed) {
+			Finish(job, JobState::Failed, status, std::move(completed.error()));
+		} else {
+			if (jobOptions.capture) {
+				jobOptions.capture(std::move(captured));
 			}
+			auto elapsed = duration_cast<microseconds>(steady_clock::now() - job->start);
+			Finish(job, JobState::Succeeded, status, std::format("Completed in {}.", FormatDuration(elapsed)));
 		}
+	}
 
-		// Errors and Warnings
-		if (module->HasErrors() || module->HasWarnings()) {
-			plg::print(Colorize("\n[Issues]", Colors::RED));
-			for (const auto& error : module->GetErrors()) {
-				plg::print("  {} {}", Colorize("ERROR:", Colors::RED), error);
+	// Keeps the most recent finished jobs for 'mamba jobs'
+	static void Prune() {
+		constexpr size_t kMaxFinished = 16;
+		size_t finished = 0;
+		for (auto it = _jobs.rbegin(); it != _jobs.rend(); ++it) {
+			if (it->second->state.load(std::memory_order_acquire) != JobState::Running) {
+				++finished;
 			}
-			for (const auto& warning : module->GetWarnings()) {
-				plg::print("  {} {}", Colorize("WARNING:", Colors::YELLOW), warning);
+		}
+		for (auto it = _jobs.begin(); it != _jobs.end() && finished > kMaxFinished;) {
+			if (it->second->state.load(std::memory_order_acquire) != JobState::Running) {
+				it = _jobs.erase(it);
+				--finished;
+			} else {
+				++it;
 			}
-		} else {
-			plg::print(
-			    "\n{} {}",
-			    Colorize(Icons.Ok, Colors::GREEN),
-			    Colorize("No issues detected", Colors::GREEN)
-			);
 		}
+	}
+
+	inline static std::mutex _mutex;
+	inline static std::map<uint64_t, std::unique_ptr<Job>> _jobs;
+	inline static uint64_t _nextId = 1;
+};
 
-		plg::print(DOUBLE_LINE);
+// Output of read-only micromamba queries, keyed by the full argument list. An entry is only
+// served while the newest mtime across envs/, the target prefix's conda-meta, pkgs/ and the
+// cached channel repodata is unchanged, and for at most kMaxAge so remote channels get re-read.
+class MambaQueryCache {
+public:
+	using Stamp = fs::file_time_type;
+
+	static constexpr std::chrono::minutes kMaxAge{ 15 };
+	static constexpr size_t kMaxEntries = 64;
+
+	struct Hit {
+		std::vector<std::string> lines;
+		std::chrono::steady_clock::duration age;
+	};
+
+	static bool IsQuery(std::string_view command) {
+		return command == "list" || command == "search" || command == "repoquery";
 	}
 
-	void ShowHealth() {
-		if (!CheckManager()) {
-			return;
+	static Stamp Fingerprint(const fs::path& baseDir, const fs::path& prefix) {
+		auto newest = Stamp::min();
+		std::error_code ec;
+		for (const auto& path : { baseDir / "envs", prefix / "conda-meta", baseDir / "pkgs" }) {
+			auto time = fs::last_write_time(path, ec);
+			if (!ec) {
+				newest = std::max(newest, time);
+			}
+		}
+		for (const auto& entry : fs::directory_iterator(baseDir / "pkgs" / "cache", ec)) {
+			auto time = entry.last_write_time(ec);
+			if (!ec) {
+				newest = std::max(newest, time);
+			}
 		}
+		return newest;
+	}
 
-		const auto& manager = s_plugify->GetManager();
-		auto report = CalculateSystemHealth(manager);
+	static std::optional<Hit> Find(const std::string& key, Stamp stamp) {
+		std::scoped_lock lock(_mutex);
+		auto it = _entries.find(key);
+		if (it == _entries.end()) {
+			++_misses;
+			return std::nullopt;
+		}
+		auto age = std::chrono::steady_clock::now() - it->second.stored;
+		if (it->second.stamp != stamp || age > kMaxAge) {
+			_entries.erase(it);
+			++_misses;
+			return std::nullopt;
+		}
+		++_hits;
+		return Hit{ it->second.lines, age };
+	}
 
-		// Determine health status color
-		ColorCode scoreColor = Colors::GREEN;
-		std::string status = "HEALTHY";
-		if (report.score < 50) {
-			scoreColor = Colors::RED;
-			status = "CRITICAL";
-		} else if (report.score < 75) {
-			scoreColor = Colors::YELLOW;
-			status = "WARNING";
+	static void Store(std::string key, Stamp stamp, std::vector<std::string> lines) {
+		std::scoped_lock lock(_mutex);
+		if (_entries.size() >= kMaxEntries && !_entries.contains(key)) {
+			auto oldest = std::ranges::min_element(_entries, {}, [](const auto& entry) { return entry.second.stored; });
+			_entries.erase(oldest);
 		}
+		_entries.insert_or_assign(std::move(key), Entry{ stamp, std::chrono::steady_clock::now(), std::move(lines) });
+	}
 
-		plg::print(DOUBLE_LINE);
-		plg::print(Colorize("SYSTEM HEALTH CHECK", Colors::ORANGE));
-		plg::print(DOUBLE_LINE);
+	static void Clear() {
+		std::scoped_lock lock(_mutex);
+		_entries.clear();
+	}
 
-		// Overall score
-		plg::print(
-		    "\n{}: {} {}",
-		    Colorize("Overall Health Score", Colors::ORANGE),
-		    Colorize(std::format("{}/100", report.score), scoreColor),
-		    Colorize(std::format("[{}]", status), scoreColor)
-		);
+	struct Stats {
+		size_t entries;
+		uint64_t hits;
+		uint64_t misses;
+	};
 
-		// Statistics
-		plg::print(Colorize("\n[Statistics]", Colors::CYAN));
-		plg::print("  Total Extensions:        {}", report.statistics["total_extensions"]);
-		plg::print(
-		    "  Failed Extensions:       {} {}",
-		    report.statistics["failed_extensions"],
-		    report.statistics["failed_extensions"] > 0 ? Colorize(Icons.Warning, Colors::RED)
-		                                               : Colorize(Icons.Ok, Colors::GREEN)
-		);
+	static Stats GetStats() {
+		std::scoped_lock lock(_mutex);
+		return { _entries.size(), _hits, _misses };
+	}
+
+private:
+	struct Entry {
+		Stamp stamp;
+		std::chrono::steady_clock::time_point stored;
+		std::vector<std::string> lines;
+	};
+
+	inline static std::mutex _mutex;
+	inline static std::unordered_map<std::string, Entry> _entries;
+	inline static uint64_t _hits = 0;
+	inline static uint64_t _misses = 0;
+};
+
+void ShowMambaJobs() {
+	auto jobs = MambaJobs::List();
+	auto cache = MambaQueryCache::GetStats();
+	plg::print("{}: {} tracked", Colorize("MAMBA JOBS", Colors::ORANGE), jobs.size());
+	plg::print(
+	    "  Query cache: {} entries, {} hits, {} misses",
+	    cache.entries,
+	    cache.hits,
+	    cache.misses
+	);
+	plg::print(SEPARATOR_LINE);
+
+	if (jobs.empty()) {
+		plg::print(Colorize("No jobs started yet.", Colors::GRAY));
+		plg::print(SEPARATOR_LINE);
+		return;
+	}
+
+	plg::print(
+	    "{} {} {} {}",
+	    Colorize(std::format("{:<6}", Icons.Number), Colors::GRAY),
+	    Colorize(std::format("{:<12}", "State"), Colors::GRAY),
+	    Colorize(std::format("{:<12}", "Elapsed"), Colors::GRAY),
+	    Colorize("Command", Colors::GRAY)
+	);
+	plg::print(SEPARATOR_LINE);
+
+	for (const auto& job : jobs) {
+		using JobState = MambaJobs::JobState;
+		ColorCode color = job.state == JobState::Running     ? Colors::CYAN
+		                  : job.state == JobState::Succeeded ? Colors::GREEN
+		                  : job.state == JobState::Cancelled ? Colors::YELLOW
+		                                                     : Colors::RED;
 		plg::print(
-		    "  Extensions with Errors:  {} {}",
-		    report.statistics["extensions_with_errors"],
-		    report.statistics["extensions_with_errors"] > 0 ? Colorize(Icons.Warning, Colors::YELLOW)
-		                                                    : Colorize(Icons.Ok, Colors::GREEN)
+		    "{:<6} {} {:<12} {}",
+		    job.id,
+		    Colorize(std::format("{:<12}", plg::enum_to_string(job.state)), color),
+		    FormatDuration(job.elapsed),
+		    Truncate(job.command, 50)
 		);
-		plg::print("  Total Warnings:          {}", report.statistics["total_warnings"]);
-		plg::print("  Slow Loading Extensions: {}", report.statistics["slow_loading_extensions"]);
+	}
+	plg::print(SEPARATOR_LINE);
+}
 
-		// Issues
-		if (!report.issues.empty()) {
-			plg::print(Colorize("\n[Critical Issues]", Colors::RED));
-			for (const auto& issue : report.issues) {
-				plg::print("  {} {}", Colorize(Icons.Fail, Colors::RED), issue);
-			}
+// Explicit lockfiles ("@EXPLICIT" followed by one package URL per line) are built straight from
+// conda-meta, so taking a snapshot needs neither micromamba nor the network
+struct CondaPackageRecord {
+	std::string name;
+	std::string url;
+	std::string md5;
+	std::string subdir;
+};
+
+fs::path ResolveBasePath(const fs::path& path) {
+	return path.is_relative() ? fs::path(Plat_GetGameDirectory()) / BASE_PATH / path : path;
+}
+
+Result<size_t> WriteExplicitLockfile(const fs::path& prefix, const fs::path& file) {
+	std::error_code ec;
+	std::vector<CondaPackageRecord> records;
+	for (const auto& entry : fs::directory_iterator(prefix / "conda-meta", ec)) {
+		if (entry.path().extension() != ".json") {
+			continue;
 		}
 
-		// Warnings
-		if (!report.warnings.empty()) {
-			plg::print(Colorize("\n[Warnings]", Colors::YELLOW));
-			for (const auto& warning : report.warnings) {
-				plg::print("  {} {}", Colorize(Icons.Warning, Colors::YELLOW), warning);
-			}
+		std::ifstream stream(entry.path(), std::ios::binary);
+		auto text = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		CondaPackageRecord record;
+		if (auto error = glz::read<glz::opts{ .error_on_unknown_keys = false }>(record, text)) {
+			return MakeError("{}: {}", plg::as_string(entry.path().filename()), glz::format_error(error, text));
 		}
+		if (record.url.empty()) {
+			return MakeError("{} has no source url, it cannot be restored offline", record.name);
+		}
+		records.push_back(std::move(record));
+	}
+	if (ec) {
+		return MakeError("Failed to read {}: {}", plg::as_string(prefix / "conda-meta"), ec.message());
+	}
+	if (records.empty()) {
+		return MakeError("No packages installed in {}", plg::as_string(prefix));
+	}
 
-		// Recommendations
-		plg::print(Colorize("\n[Recommendations]", Colors::CYAN));
-		if (report.score == 100) {
-			plg::print("  {} System is running optimally!", Colorize(Icons.Ok, Colors::GREEN));
-		} else {
-			if (report.statistics["failed_extensions"] > 0) {
-				plg::print("  • Fix or remove failed extensions");
-			}
-			if (report.statistics["extensions_with_errors"] > 0) {
-				plg::print("  • Review and resolve extension errors");
-			}
-			if (report.statistics["slow_loading_extensions"] > 0) {
-				plg::print("  • Investigate slow-loading extensions for optimization");
+	std::ranges::sort(records, {}, &CondaPackageRecord::name);
+	auto platform = std::ranges::find_if(records, [](const auto& record) { return record.subdir != "noarch"; });
+
+	std::string content;
+	std::format_to(std::back_inserter(content), "# This file may be used to create an environment using:\n");
+	std::format_to(std::back_inserter(content), "# $ micromamba create --offline --file <this file>\n");
+	std::format_to(
+	    std::back_inserter(content),
+	    "# platform: {}\n@EXPLICIT\n",
+	    platform != records.end() ? platform->subdir : "noarch"
+	);
+	for (const auto& record : records) {
+		std::format_to(std::back_inserter(content), "{}{}{}\n", record.url, record.md5.empty() ? "" : "#", record.md5);
+	}
+
+	fs::create_directories(file.parent_path(), ec);
+	std::ofstream out(file, std::ios::binary | std::ios::trunc);
+	out.write(content.data(), static_cast<std::streamsize>(content.size()));
+	if (!out) {
+		return MakeError("Failed to write {}", plg::as_string(file));
+	}
+	return records.size();
+}
+
+// Package archives named by an explicit lockfile that are neither downloaded nor extracted in pkgs/
+Result<std::vector<std::string>> FindUncachedPackages(const fs::path& file, const fs::path& pkgsDir) {
+	std::ifstream stream(file);
+	if (!stream) {
+		return MakeError("Failed to open {}", plg::as_string(file));
+	}
+
+	std::vector<std::string> missing;
+	bool explicitSection = false;
+	size_t packages = 0;
+	for (std::string line; std::getline(stream, line);) {
+		std::string_view view = line;
+		if (view.ends_with('\r')) {
+			view.remove_suffix(1);
+		}
+		if (view.empty() || view.starts_with('#')) {
+			continue;
+		}
+		if (view == "@EXPLICIT") {
+			explicitSection = true;
+			continue;
+		}
+		if (!explicitSection) {
+			continue;
+		}
+
+		++packages;
+		auto archive = view.substr(0, view.find('#'));
+		archive = archive.substr(archive.find_last_of('/') + 1);
+		auto extracted = archive;
+		for (std::string_view suffix : { ".tar.bz2", ".conda" }) {
+			if (extracted.ends_with(suffix)) {
+				extracted.remove_suffix(suffix.size());
+				break;
 			}
 		}
 
-		plg::print(DOUBLE_LINE);
+		std::error_code ec;
+		if (!fs::exists(pkgsDir / archive, ec) && !fs::is_directory(pkgsDir / extracted, ec)) {
+			missing.emplace_back(archive);
+		}
 	}
 
-	void ShowDependencyTree(std::string_view name, bool useId = false) {
-		if (!CheckManager()) {
-			return;
-		}
+	if (!explicitSection || packages == 0) {
+		return MakeError("{} is not an explicit lockfile", plg::as_string(file));
+	}
+	return missing;
+}
 
-		const auto& manager = s_plugify->GetManager();
-		auto ext = useId ? manager.FindExtension(FormatId(name)) : manager.FindExtension(name);
+void SnapshotEnvironment(const std::string& env, const fs::path& file) {
+	if (env.empty()) {
+		plg::print("{}: No environment selected, run 'mamba activate <env>' or pass -n.", Colorize("Error", Colors::RED));
+		return;
+	}
 
-		if (!ext) {
-			plg::print("{} {} not found.", Colorize("Error:", Colors::RED), name);
-			return;
+	TaskPool::Run(
+	    [prefix = EnvironmentDir(env), path = ResolveBasePath(file)] {
+		    return std::pair{ WriteExplicitLockfile(prefix, path), path };
+	    },
+	    [env](std::pair<Result<size_t>, fs::path> result) {
+		    auto& [written, path] = result;
+		    if (!written) {
+			    plg::print("{}: Snapshot of {} failed - {}", Colorize("Error", Colors::RED), env, written.error());
+			    return;
+		    }
+		    plg::print(
+		        "{}: Saved {} packages of {} to {}",
+		        Colorize("Success", Colors::GREEN),
+		        *written,
+		        Colorize(env, Colors::CYAN),
+		        plg::as_string(path)
+		    );
+	    }
+	);
+}
+
+// micromamba writes the install prefix into files that carry a prefix placeholder and into the
+// entry points it generates. A staged environment is installed at staging/<env> but runs from
+// envs/<env> after the swap, so those files are rewritten to the final prefix once the job is done.
+struct CondaPathEntry {
+	std::string _path;
+	std::string path_type;
+	std::string prefix_placeholder;
+	std::string file_mode;
+};
+
+struct CondaPathsData {
+	std::vector<CondaPathEntry> paths;
+};
+
+struct CondaLinkedRecord {
+	std::string name;
+	CondaPathsData paths_data;
+};
+
+// Text files get a plain replacement. Binary files keep their layout: every C string holding the
+// prefix is rewritten in place and padded with NULs, the way conda fills binary placeholders, so
+// 'to' must not be longer than 'from'.
+Result<bool> RelocateFile(const fs::path& file, std::string_view from, std::string_view to, bool binary) {
+	std::ifstream in(file, std::ios::binary);
+	if (!in) {
+		return MakeError("Failed to open {}", plg::as_string(file));
+	}
+	auto content = std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	in.close();
+
+	auto replaceAll = [&](std::string text) {
+		for (size_t pos = 0; (pos = text.find(from, pos)) != std::string::npos; pos += to.size()) {
+			text.replace(pos, from.size(), to);
 		}
+		return text;
+	};
 
-		plg::print(DOUBLE_LINE);
-		plg::print("{}: {}", Colorize("DEPENDENCY TREE", Colors::ORANGE), ext->GetName());
-		plg::print(DOUBLE_LINE);
-		plg::print("");
+	auto first = content.find(from);
+	if (first == std::string::npos) {
+		return false;
+	}
+	if (!binary) {
+		content = replaceAll(std::move(content));
+	} else {
+		for (auto pos = first; pos != std::string::npos; pos = content.find(from, pos)) {
+			auto end = std::min(content.find('\0', pos), content.size());
+			auto segment = replaceAll(content.substr(pos, end - pos));
+			segment.resize(end - pos, '\0');
+			content.replace(pos, end - pos, segment);
+			pos = end;
+		}
+	}
 
-		PrintDependencyTree(ext, manager);
+	// Through a temporary so a file hard-linked from pkgs/ is never modified in place
+	std::error_code ec;
+	auto temp = fs::path(file).concat(".relocate");
+	{
+		std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+		out.write(content.data(), static_cast<std::streamsize>(content.size()));
+		if (!out) {
+			fs::remove(temp, ec);
+			return MakeError("Failed to write {}", plg::as_string(temp));
+		}
+	}
+	fs::permissions(temp, fs::status(file, ec).permissions(), ec);
+	fs::rename(temp, file, ec);
+	if (ec) {
+		fs::remove(temp, ec);
+		return MakeError("Failed to replace {}: {}", plg::as_string(file), ec.message());
+	}
+	return true;
+}
 
-		// Also show what depends on this extension
-		plg::print(Colorize("\n[Reverse Dependencies]", Colors::CYAN));
-		plg::print("Extensions that depend on this:");
+// Rewrites 'from' to 'to' in the prefix-bearing files of every package linked since 'since'.
+// Returns the number of files changed.
+Result<size_t> RelocatePrefix(const fs::path& prefix, const fs::path& from, const fs::path& to, fs::file_time_type since) {
+	std::vector<std::pair<std::string, std::string>> replacements;
+	for (auto [source, target] : { std::pair{ from.string(), to.string() }, std::pair{ from.generic_string(), to.generic_string() } }) {
+		if (source.size() < target.size()) {
+			return MakeError("{} is longer than {}, it cannot be relocated", plg::as_string(to), plg::as_string(from));
+		}
+		if (std::ranges::find(replacements, std::pair{ source, target }) == replacements.end()) {
+			replacements.emplace_back(std::move(source), std::move(target));
+		}
+	}
 
-		bool found = false;
-		for (const auto& other : manager.GetExtensions()) {
-			for (const auto& dep : other->GetDependencies()) {
-				if (dep.GetName() == ext->GetName()) {
-					plg::print(
-					    "  • {} {}",
-					    other->GetName(),
-					    dep.IsOptional() ? Colorize("[optional]", Colors::GRAY) : ""
-					);
-					found = true;
-				}
-			}
+	std::error_code ec;
+	size_t changed = 0;
+	for (const auto& entry : fs::directory_iterator(prefix / "conda-meta", ec)) {
+		if (entry.path().extension() != ".json" || entry.last_write_time(ec) < since) {
+			continue;
 		}
 
-		if (!found) {
-			plg::print("  {}", Colorize("None", Colors::GRAY));
+		std::ifstream stream(entry.path(), std::ios::binary);
+		auto text = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		CondaLinkedRecord record;
+		if (auto error = glz::read<glz::opts{ .error_on_unknown_keys = false }>(record, text)) {
+			return MakeError("{}: {}", plg::as_string(entry.path().filename()), glz::format_error(error, text));
 		}
 
-		plg::print(DOUBLE_LINE);
+		for (const auto& path : record.paths_data.paths) {
+			if (path.prefix_placeholder.empty() && path.path_type.find("entry_point") == std::string::npos) {
+				continue;
+			}
+			auto file = prefix / path._path;
+			if (fs::is_symlink(file, ec) || !fs::is_regular_file(file, ec)) {
+				continue;
+			}
+			for (const auto& [source, target] : replacements) {
+				auto result = RelocateFile(file, source, target, path.file_mode == "binary");
+				if (!result) {
+					return MakeError("{}: {}", record.name, result.error());
+				}
+				changed += *result ? 1 : 0;
+			}
+		}
+	}
+	if (ec) {
+		return MakeError("Failed to read {}: {}", plg::as_string(prefix / "conda-meta"), ec.message());
 	}
+	return changed;
+}
 
-	void SearchExtensions(std::string_view query) {
-		if (!CheckManager()) {
-			return;
+// Completion step of a staged job: points what it just linked at envs/<env>, where the files run
+// after the swap
+std::move_only_function<Result<void>()> RelocateStagedJob(const fs::path& stagedDir, const fs::path& live) {
+	// A margin for filesystems with coarse timestamps
+	auto since = fs::file_time_type::clock::now() - std::chrono::seconds(2);
+	return [stagedDir, live, since]() -> Result<void> {
+		auto relocated = RelocatePrefix(stagedDir, fs::absolute(stagedDir).lexically_normal(), fs::absolute(live).lexically_normal(), since);
+		if (!relocated) {
+			// Half relocated is worse than nothing, it must never be swapped in
+			std::error_code ec;
+			fs::remove_all(stagedDir, ec);
+			return MakeError("Failed to relocate staged environment, discarded it: {}", relocated.error());
 		}
+		return {};
+	};
+}
 
-		const auto& manager = s_plugify->GetManager();
-		auto allExtensions = manager.GetExtensions();
+// Recreates the environment offline into staging/<env>; 'plugify swap' then activates it
+void RestoreEnvironment(const std::string& env, const fs::path& file) {
+	if (env.empty()) {
+		plg::print("{}: No environment selected, run 'mamba activate <env>' or pass -n.", Colorize("Error", Colors::RED));
+		return;
+	}
 
-		std::vector<const Extension*> matches;
-		std::string lowerQuery(query);
-		std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
+	fs::path gameDir(Plat_GetGameDirectory());
+	fs::path baseDir = gameDir / BASE_PATH;
+	fs::path exePath = gameDir / MAMBA_PATH;
 
-		for (const auto& ext : allExtensions) {
-			std::string name = ext->GetName();
-			std::string desc = ext->GetDescription();
-			std::string author = ext->GetAuthor();
+	std::error_code ec;
+	if (!fs::exists(exePath, ec)) {
+		plg::print("{}: {} missing - {}", Colorize("Error", Colors::RED), Colorize("micromamba", Colors::CYAN), plg::as_string(exePath));
+		return;
+	}
 
-			std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-			std::transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
-			std::transform(author.begin(), author.end(), author.begin(), ::tolower);
+	auto lockfile = ResolveBasePath(file);
+	auto stagedDir = StagingDir() / env;
+	auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	// micromamba hard-links from pkgs/ unless it has to copy, --offline keeps it off the network
+	std::vector<std::string> cmd{
+		plg::as_string(exePath),
+		"create",
+		"-y",
+		"-r", plg::as_string(baseDir),
+		"-p", plg::as_string(stagedDir),
+		"--offline",
+		"--extract-threads", std::to_string(threads),
+		"--file", plg::as_string(lockfile),
+	};
 
-			if (name.find(lowerQuery) != std::string::npos || desc.find(lowerQuery) != std::string::npos
-			    || author.find(lowerQuery) != std::string::npos) {
-				matches.push_back(ext);
+	MambaJobs::Options options;
+	options.prepare = [lockfile, stagedDir, pkgsDir = baseDir / "pkgs"]() -> Result<void> {
+		auto missing = FindUncachedPackages(lockfile, pkgsDir);
+		if (!missing) {
+			return MakeError(std::move(missing.error()));
+		}
+		if (!missing->empty()) {
+			std::string examples;
+			for (const auto& archive : std::span(*missing).first(std::min<size_t>(missing->size(), 3))) {
+				std::format_to(std::back_inserter(examples), "{}{}", examples.empty() ? "" : ", ", archive);
 			}
+			return MakeError("{} packages are not in the pkgs cache, e.g. {}", missing->size(), examples);
 		}
 
-		if (matches.empty()) {
-			plg::print(
-			    "{} No extensions found matching '{}'",
-			    Colorize(Icons.Missing, Colors::YELLOW),
-			    query
-			);
-			return;
+		std::error_code ec;
+		fs::remove_all(stagedDir, ec);
+		if (ec) {
+			return MakeError("Failed to clear {}: {}", plg::as_string(stagedDir), ec.message());
 		}
+		return {};
+	};
+	options.complete = RelocateStagedJob(stagedDir, EnvironmentDir(env));
+	options.prefix = stagedDir;
 
-		plg::print(
-		    "{}: Found {} match{} for '{}'",
-		    Colorize("SEARCH RESULTS", Colors::ORANGE),
-		    matches.size(),
-		    matches.size() > 1 ? "es" : "",
-		    query
-		);
-		plg::print(SEPARATOR_LINE);
+	auto id = MambaJobs::Launch(std::move(cmd), std::format("env restore {} {}", env, plg::as_string(file)), std::move(options));
+	if (!id) {
+		plg::print("{}: {}", Colorize("Error", Colors::RED), id.error());
+		return;
+	}
+	plg::print(
+	    "{}: Restoring {} offline as job #{}, run '{}' once it completes.",
+	    Colorize("Info", Colors::BLUE),
+	    Colorize(env, Colors::CYAN),
+	    *id,
+	    Colorize("plugify swap", Colors::CYAN)
+	);
+}
 
-		for (const auto& ext : matches) {
-			auto [symbol, color] = GetStateInfo(ext->GetState());
-			plg::print(
-			    "{} {} {} {} {}",
-			    Colorize(symbol, color),
-			    Colorize(ext->GetName(), Colors::ORANGE),
-			    Colorize(ext->GetVersionString(), Colors::GRAY),
-			    ext->IsPlugin() ? "[Plugin]" : "[Module]",
-			    Colorize(std::format("({})", ext->GetLanguage()), Colors::GRAY)
-			);
+// Marks console command dispatch for USDT consumers and the flight recorder
+struct ConsoleProbe {
+	explicit ConsoleProbe(const CCommand& args)
+	    : name(args.Arg(0))
+	    , line(args.GetCommandString())
+	    , recording(CommandRecorder::IsRecording()) {
+		S2_PROBE1(command__begin, name);
+		FlightRecorder::Record(
+		    FlightRecorder::EventType::Command,
+		    0,
+		    static_cast<uint32_t>(args.ArgC()),
+		    0,
+		    line
+		);
+	}
 
-			if (!ext->GetDescription().empty()) {
-				plg::print("  {}", Truncate(ext->GetDescription(), 70));
-			}
+	~ConsoleProbe() {
+		S2_PROBE1(command__end, name);
+		// Commands that start or stop the recording are left out of it
+		if (recording) {
+			CommandRecorder::Record(
+			    line,
+			    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+			);
 		}
-		plg::print(SEPARATOR_LINE);
 	}
 
-	void ValidateExtension(const fs::path& path) {
-		plg::print("{}: {}", Colorize("VALIDATING", Colors::ORANGE), plg::as_string(path));
-		plg::print(SEPARATOR_LINE);
+	const char* name;
+	const char* line;
+	bool recording;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
 
-		// Check if file exists
-		std::error_code ec;
-		if (!fs::exists(path, ec)) {
-			plg::print("{} File does not exist", Colorize("✗", Colors::RED));
-			return;
-		}
+// Parser behind the plugify console command. The CLI11 tree and the option storage are built
+// once on first use; every invocation only resets the bound values and re-parses.
+class PlugifyCommandLine {
+public:
+	static void Execute(const CCommand& args) {
+		static PlugifyCommandLine command;
+		command.Run(args);
+	}
 
-		// Check file extension
-		const auto& fileExt = plg::as_string(path.extension());
-		bool isPlugin = (fileExt == ".plg" || fileExt == ".pplugin");
-		bool isModule = (fileExt == ".mod" || fileExt == ".pmodule");
+private:
+	// Values bound to the options, restored to these defaults before every parse
+	struct Options {
+		bool jsonOutput = false;
+		std::string output;
+
+		std::string pluginFilterState;
+		std::string pluginFilterLang;
+		std::string pluginSortBy = "name";
+		bool pluginReverse = false;
+		bool pluginShowFailed = false;
+
+		std::string moduleFilterState;
+		std::string moduleFilterLang;
+		std::string moduleSortBy = "name";
+		bool moduleReverse = false;
+		bool moduleShowFailed = false;
+
+		std::string plugin_name;
+		bool plugin_use_id = false;
+		std::string module_name;
+		bool module_use_id = false;
+		std::string tree_name;
+		bool tree_use_id = false;
+		PageOptions page;
+		std::string reload_name;
+
+		int traceDuration = 0;
+		int profileHz = 99;
+		bool perfCounters = false;
+		bool perfDisable = false;
+		bool perfArena = false;
+
+		std::string envFile;
+		std::string envName;
+		bool benchQuick = false;
+
+		std::string recordFile;
+
+		std::string swapEnv;
+		std::string flightFile;
+		size_t flightLast = 50;
+
+		std::optional<int> watchdogStall;
+		std::optional<int> watchdogAbort;
+		bool watchdogNoDump = false;
+		bool watchdogDisable = false;
+
+		std::string search_query;
+		std::string validate_path;
+		std::string compare_ext1;
+		std::string compare_ext2;
+		bool compare_use_id = false;
+	};
 
-		if (!isPlugin && !isModule) {
-			plg::print("{} Invalid file extension: {}", Colorize("✗", Colors::RED), fileExt);
-			return;
-		}
+	// Subcommands that take no arguments besides --json skip CLI11 entirely
+	using FastHandler = void (*)(bool jsonOutput);
+	static constexpr std::pair<std::string_view, FastHandler> kFastPath[] = {
+		{ "plugins", [](bool json) { ListPlugins({}, SortBy::Name, false, json); } },
+		{ "modules", [](bool json) { ListModules({}, SortBy::Name, false, json); } },
+		{ "health", [](bool) { ShowHealth(); } },
+		{ "queue", [](bool json) { ShowCommandQueue(json); } },
+		{ "pool", [](bool json) { ShowTaskPool(json); } },
+		{ "load", [](bool) { LoadManager(); } },
+		{ "unload", [](bool) { UnloadManager(); } },
+		{ "reload", [](bool) { ReloadManager(); } },
+	};
 
-		plg::print("{} File exists", Colorize(Icons.Ok, Colors::GREEN));
-		plg::print(
-		    "{} Valid extension type: {}",
-		    Colorize(Icons.Ok, Colors::GREEN),
-		    isPlugin ? "Plugin" : "Module"
+	PlugifyCommandLine() {
+		_app.require_subcommand();  // 1 or more
+		// interactiveApp.allow_extras();
+		// interactiveApp.prefix_command();
+		_app.set_version_flag("-v,--version", GetVersionString());
+		_app.usage("Usage: plugify <command> [options]");
+		// flag to display full help at once
+		_app.set_help_flag();
+		_app.set_help_all_flag("-h, --help", "Print this help message and exit");
+
+		auto& o = _options;
+
+		// Global options
+		_app.add_flag("-j,--json", o.jsonOutput, "Output in JSON format");
+		_app.add_option("-o,--output", o.output, "Write the report to a file inside logs/data");
+
+		// Runs once parsing succeeded, before any subcommand callback prints
+		_app.parse_complete_callback([this]() {
+			if (!_options.output.empty()) {
+				_captured.clear();
+				_capture.emplace(_captured);
+			}
+		});
+
+		// Add all commands (similar to main but simplified)
+		auto* load = _app.add_subcommand("load", "Load manager");
+		auto* unload = _app.add_subcommand("unload", "Unload manager");
+		auto* reload = _app.add_subcommand("reload", "Reload manager");
+		auto* plugins = _app.add_subcommand("plugins", "List plugins");
+		auto* modules = _app.add_subcommand("modules", "List modules");
+		// Show plugin/module commands
+		auto* plugin = _app.add_subcommand("plugin", "Show plugin information");
+		auto* module = _app.add_subcommand("module", "Show module information");
+		auto* health = _app.add_subcommand("health", "System health");
+		auto* tree = _app.add_subcommand("tree", "Show dependency tree");
+		auto* search = _app.add_subcommand("search", "Search extensions");
+		auto* validate = _app.add_subcommand("validate", "Validate extension file");
+		auto* compare = _app.add_subcommand("compare", "Compare two extensions");
+		auto* queue = _app.add_subcommand("queue", "Show pending and recent manager commands");
+		auto* trace = _app.add_subcommand("trace", "Capture a runtime trace");
+		auto* profile = _app.add_subcommand("profile", "Sample CPU usage per extension");
+		auto* perf = _app.add_subcommand("perf", "Show performance data");
+		auto* watchdog = _app.add_subcommand("watchdog", "Show or configure the stall watchdog");
+		auto* flight = _app.add_subcommand("flight", "Decode the flight recorder");
+		auto* pool = _app.add_subcommand("pool", "Show task pool statistics");
+		auto* swap = _app.add_subcommand("swap", "Activate the staged environment and reload");
+		auto* env = _app.add_subcommand("env", "Snapshot or restore a package environment");
+		auto* record = _app.add_subcommand("record", "Record console commands for the --plugify-replay harness");
+		auto* bench = _app.add_subcommand("bench", "Run the built-in host benchmark");
+
+		// Enhanced list commands with filters and sorting
+		plugins->add_option(
+		    "--filter-state",
+		    o.pluginFilterState,
+		    "Filter by state (comma-separated: loaded,failed,disabled)"
+		);
+		plugins->add_option(
+		    "--filter-lang",
+		    o.pluginFilterLang,
+		    "Filter by language (comma-separated: cpp,python,rust)"
 		);
-		plg::print("{} File size: {}", Colorize(Icons.Missing, Colors::CYAN), FormatFileSize(path));
+		plugins
+		    ->add_option("-s,--sort", o.pluginSortBy, "Sort by: name, version, state, language, loadtime")
+		    ->check(CLI::IsMember({ "name", "version", "state", "language", "loadtime" }));
+		plugins->add_flag("-r,--reverse", o.pluginReverse, "Reverse sort order");
+		plugins->add_flag("-f,--failed", o.pluginShowFailed, "Show only failed plugins");
+
+		modules->add_option("--filter-state", o.moduleFilterState, "Filter by state (comma-separated)");
+		modules->add_option("--filter-lang", o.moduleFilterLang, "Filter by language (comma-separated)");
+		modules
+		    ->add_option("-s,--sort", o.moduleSortBy, "Sort by: name, version, state, language, loadtime")
+		    ->check(CLI::IsMember({ "name", "version", "state", "language", "loadtime" }));
+		modules->add_flag("-r,--reverse", o.moduleReverse, "Reverse sort order");
+		modules->add_flag("-f,--failed", o.moduleShowFailed, "Show only failed modules");
+
+		// Add options for plugin/module
+		plugin->add_option("name", o.plugin_name, "Plugin name or ID")->required();
+		plugin->add_flag("-u,--uuid", o.plugin_use_id, "Use ID instead of name");
+		plugin->validate_positionals();
+
+		module->add_option("name", o.module_name, "Module name or ID")->required();
+		module->add_flag("-u,--uuid", o.module_use_id, "Use ID instead of name");
+		module->validate_positionals();
+
+		tree->add_option("name", o.tree_name, "Extension name or ID")->required();
+		tree->add_flag("-u,--uuid", o.tree_use_id, "Use ID instead of name");
+		tree->validate_positionals();
+
+		// Slicing for the listings that can grow into thousands of lines
+		for (auto* sub : { plugins, modules, tree }) {
+			sub->add_option("--page", o.page.page, "Page number (1-based), pages are --limit entries long")
+			    ->check(CLI::PositiveNumber);
+			sub->add_option("--offset", o.page.offset, "Skip the first N entries");
+			sub->add_option("--limit", o.page.limit, "Show at most N entries (0 for all)");
+		}
+
+		reload->add_option("name", o.reload_name, "Reload a single extension (name)");
+		reload->validate_positionals();
+
+		trace->require_subcommand(1);
+		auto* traceStart = trace->add_subcommand("start", "Start trace capture");
+		auto* traceStop = trace->add_subcommand("stop", "Stop trace capture and write the file");
+		traceStart->add_option("-d,--duration", o.traceDuration, "Stop automatically after N seconds")
+		    ->check(CLI::NonNegativeNumber);
+
+		profile->require_subcommand(1);
+		auto* profileStart = profile->add_subcommand("start", "Start sampling the game thread");
+		auto* profileStop = profile->add_subcommand("stop", "Stop sampling and write folded stacks");
+		profileStart->add_option("--hz", o.profileHz, "Sampling frequency")->check(CLI::Range(1, 10000));
+
+		perf->add_flag("-c,--counters", o.perfCounters, "Hardware counters around Update(), opened on first use");
+		perf->add_flag("--disable", o.perfDisable, "Close the hardware counters");
+		perf->add_flag("--arena", o.perfArena, "Scratch arena usage of the previous command");
+
+		env->require_subcommand(1);
+		auto* envSnapshot = env->add_subcommand("snapshot", "Export an explicit lockfile of the environment");
+		auto* envRestore = env->add_subcommand("restore", "Recreate an environment offline from the pkgs cache");
+		for (auto* sub : { envSnapshot, envRestore }) {
+			sub->add_option("file", o.envFile, "Lockfile path (relative to the plugify directory)")->required();
+			sub->add_option("-n,--name", o.envName, "Environment name (defaults to the active one)");
+			sub->validate_positionals();
+		}
+
+		bench->add_flag("-q,--quick", o.benchQuick, "Shorter run with fewer samples");
+
+		record->require_subcommand(1);
+		auto* recordStart = record->add_subcommand("start", "Start recording console commands");
+		auto* recordStop = record->add_subcommand("stop", "Stop recording and write the command log");
+		recordStop->add_option("file", o.recordFile, "Output file (relative to logs)");
+		recordStop->validate_positionals();
+
+		swap->add_option("env", o.swapEnv, "Environment name (defaults to the active one)");
+		swap->validate_positionals();
+
+		flight->add_option("file", o.flightFile, "Ring file to decode (relative to logs), live ring if omitted");
+		flight->add_option("-n,--last", o.flightLast, "Number of most recent events (0 for all)");
+		flight->validate_positionals();
+
+		watchdog->add_option("--stall", o.watchdogStall, "Stall threshold in ms (0 disables)")->check(CLI::NonNegativeNumber);
+		watchdog->add_option("--abort", o.watchdogAbort, "Terminate after a stall of N ms (0 never)")->check(CLI::NonNegativeNumber);
+		watchdog->add_flag("--no-dump", o.watchdogNoDump, "Do not write a minidump on stall");
+		watchdog->add_flag("--disable", o.watchdogDisable, "Stop the watchdog");
+
+		search->add_option("query", o.search_query, "Search query")->required();
+		search->validate_positionals();
+
+		validate->add_option("path", o.validate_path, "Path to extension file")->required();
+		validate->validate_positionals();
+
+		compare->add_option("extension1", o.compare_ext1, "First extension")->required();
+		compare->add_option("extension2", o.compare_ext2, "Second extension")->required();
+		compare->add_flag("-u,--uuid", o.compare_use_id, "Use ID instead of name");
+		compare->validate_positionals();
+
+		// Set callbacks, the options object outlives the tree so capturing it is safe
+		load->callback([]() { LoadManager(); });
+		unload->callback([]() { UnloadManager(); });
+		reload->callback([&o]() { ReloadManager(o.reload_name); });
+
+		plugins->callback([&o]() {
+			FilterOptions filter;
+			if (!o.pluginFilterState.empty()) {
+				filter.states = ParseStates(ParseCsv(o.pluginFilterState));
+			}
+			if (!o.pluginFilterLang.empty()) {
+				filter.languages = ParseCsv(o.pluginFilterLang);
+			}
+			filter.showOnlyFailed = o.pluginShowFailed;
 
-		// Try to parse manifest (you'd need to implement manifest parsing)
-		// This is a placeholder for actual validation logic
-		/*plg::print("{} Manifest validation: {}",
-		            Colorize(Icons.Missing, Colors::CYAN),
-		            "Would parse and validate manifest here");*/
-		// TODO
+			ListPlugins(filter, ParseSortBy(o.pluginSortBy), o.pluginReverse, o.jsonOutput, o.page);
+		});
 
-		plg::print(SEPARATOR_LINE);
-		plg::print("{}: Validation complete", Colorize("RESULT", Colors::ORANGE));
-	}
+		modules->callback([&o]() {
+			FilterOptions filter;
+			if (!o.moduleFilterState.empty()) {
+				filter.states = ParseStates(ParseCsv(o.moduleFilterState));
+			}
+			if (!o.moduleFilterLang.empty()) {
+				filter.languages = ParseCsv(o.moduleFilterLang);
+			}
+			filter.showOnlyFailed = o.moduleShowFailed;
 
-	void CompareExtensions(std::string_view name1, std::string_view name2, bool useId = false) {
-		if (!CheckManager()) {
-			return;
-		}
+			ListModules(filter, ParseSortBy(o.moduleSortBy), o.moduleReverse, o.jsonOutput, o.page);
+		});
 
-		const auto& manager = s_plugify->GetManager();
-		auto ext1 = useId ? manager.FindExtension(FormatId(name1)) : manager.FindExtension(name1);
-		auto ext2 = useId ? manager.FindExtension(FormatId(name2)) : manager.FindExtension(name2);
+		plugin->callback([&o]() { ShowPlugin(o.plugin_name, o.plugin_use_id, o.jsonOutput); });
 
-		if (!ext1) {
-			plg::print("{}: Extension {} not found.", Colorize("Error", Colors::RED), name1);
-			return;
-		}
-		if (!ext2) {
-			plg::print("{}: Extension {} not found.", Colorize("Error", Colors::RED), name2);
-			return;
-		}
+		module->callback([&o]() { ShowModule(o.module_name, o.module_use_id, o.jsonOutput); });
 
-		plg::print(DOUBLE_LINE);
-		plg::print(Colorize("EXTENSION COMPARISON", Colors::ORANGE));
-		plg::print(DOUBLE_LINE);
+		health->callback([]() { ShowHealth(); });
 
-		// Basic comparison table
-		auto printRow = [](std::string_view label, std::string_view val1, std::string_view val2) {
-			bool same = (val1 == val2);
-			plg::print("{:<20} {:<25} {} {:<25}", label, val1, same ? Icons.Equal : Icons.NotEqual, val2);
-		};
+		queue->callback([&o]() { ShowCommandQueue(o.jsonOutput); });
 
-		plg::print(
-		    "\n{:<20} {:<25}   {:<25}",
-		    "",
-		    Colorize(ext1->GetName(), Colors::CYAN),
-		    Colorize(ext2->GetName(), Colors::MAGENTA)
-		);
-		plg::print(SEPARATOR_LINE);
+		traceStart->callback([&o]() { StartRuntimeTrace(o.traceDuration); });
+		traceStop->callback([]() { StopRuntimeTrace(); });
 
-		printRow("Type:", ext1->IsPlugin() ? "Plugin" : "Module", ext2->IsPlugin() ? "Plugin" : "Module");
-		printRow("Version:", ext1->GetVersionString(), ext2->GetVersionString());
-		printRow("Language:", ext1->GetLanguage(), ext2->GetLanguage());
-		printRow("State:", plg::enum_to_string(ext1->GetState()), plg::enum_to_string(ext2->GetState()));
-		printRow("Author:", ext1->GetAuthor(), ext2->GetAuthor());
-		printRow("License:", ext1->GetLicense(), ext2->GetLicense());
+		profileStart->callback([&o]() { StartProfiler(o.profileHz); });
+		profileStop->callback([]() { StopProfiler(); });
 
-		// Dependencies comparison
-		plg::print(Colorize("\n[Dependencies]", Colors::ORANGE));
-		auto deps1 = ext1->GetDependencies();
-		auto deps2 = ext2->GetDependencies();
+		pool->callback([&o]() { ShowTaskPool(o.jsonOutput); });
 
-		std::set<std::string> depNames1, depNames2;
-		for (const auto& d : deps1) {
-			depNames1.insert(d.GetName());
-		}
-		for (const auto& d : deps2) {
-			depNames2.insert(d.GetName());
-		}
+		bench->callback([&o]() { StartHostBench(o.benchQuick, o.jsonOutput); });
 
-		std::vector<std::string> onlyIn1, onlyIn2, common;
-		std::set_difference(
-		    depNames1.begin(),
-		    depNames1.end(),
-		    depNames2.begin(),
-		    depNames2.end(),
-		    std::back_inserter(onlyIn1)
-		);
-		std::set_difference(
-		    depNames2.begin(),
-		    depNames2.end(),
-		    depNames1.begin(),
-		    depNames1.end(),
-		    std::back_inserter(onlyIn2)
-		);
-		std::set_intersection(
-		    depNames1.begin(),
-		    depNames1.end(),
-		    depNames2.begin(),
-		    depNames2.end(),
-		    std::back_inserter(common)
-		);
+		recordStart->callback([]() { StartCommandRecording(); });
+		recordStop->callback([&o]() { StopCommandRecording(o.recordFile); });
 
-		if (!common.empty()) {
-			plg::print("  Common: {}", plg::join(common, ", "));
+		swap->callback([&o]() { SwapEnvironment(o.swapEnv.empty() ? s_mambaEnv : o.swapEnv); });
+
+		envSnapshot->callback([&o]() { SnapshotEnvironment(o.envName.empty() ? s_mambaEnv : o.envName, o.envFile); });
+		envRestore->callback([&o]() { RestoreEnvironment(o.envName.empty() ? s_mambaEnv : o.envName, o.envFile); });
+
+		flight->callback([&o]() { ShowFlightRecorder(o.flightFile, o.flightLast, o.jsonOutput); });
+
+		watchdog->callback([&o]() {
+			ConfigureWatchdog(o.watchdogStall, o.watchdogAbort, o.watchdogNoDump, o.watchdogDisable);
+		});
+
+		perf->callback([&o]() {
+			if (o.perfArena) {
+				ShowArenaUsage(o.jsonOutput);
+				return;
+			}
+			if (!o.perfCounters && !o.perfDisable) {
+				plg::print("Usage: plugify perf --counters [--disable] | --arena");
+				return;
+			}
+			ShowPerfCounters(o.perfDisable, o.jsonOutput);
+		});
+
+		tree->callback([&o]() { ShowDependencyTree(o.tree_name, o.tree_use_id, o.page); });
+
+		search->callback([&o]() {
+			if (!o.search_query.empty()) {
+				SearchExtensions(o.search_query);
+			} else {
+				plg::print("Search query required");
+			}
+		});
+
+		validate->callback([&o]() { ValidateExtension(o.validate_path); });
+
+		compare->callback([&o]() { CompareExtensions(o.compare_ext1, o.compare_ext2, o.compare_use_id); });
+	}
+
+	// Handles "<cmd> <subcommand> [-j|--json]" in any order, returns false if CLI11 is needed
+	bool RunFastPath(const CCommand& args) const {
+		std::string_view subcommand;
+		bool jsonOutput = false;
+		for (int i = 1; i < args.ArgC(); ++i) {
+			std::string_view arg = args.Arg(i);
+			if (arg == "-j" || arg == "--json") {
+				jsonOutput = true;
+			} else if (subcommand.empty()) {
+				subcommand = arg;
+			} else {
+				return false;
+			}
 		}
-		if (!onlyIn1.empty()) {
-			plg::print("  Only in {}: {}", ext1->GetName(), plg::join(onlyIn1, ", "));
+
+		for (const auto& [name, handler] : kFastPath) {
+			if (name == subcommand) {
+				handler(jsonOutput);
+				return true;
+			}
 		}
-		if (!onlyIn2.empty()) {
-			plg::print("  Only in {}: {}", ext2->GetName(), plg::join(onlyIn2, ", "));
+		return false;
+	}
+
+	void Run(const CCommand& args) {
+		if (RunFastPath(args)) {
+			return;
 		}
 
-		// Performance comparison
-		plg::print(Colorize("\n[Performance]", Colors::ORANGE));
-		plg::print(
-		    "  Load Time:     {:<15} vs {:<15}",
-		    FormatDuration(ext1->GetOperationTime(ExtensionState::Loaded)),
-		    FormatDuration(ext2->GetOperationTime(ExtensionState::Loaded))
-		);
-		plg::print(
-		    "  Total Time:    {:<15} vs {:<15}",
-		    FormatDuration(ext1->GetTotalTime()),
-		    FormatDuration(ext2->GetTotalTime())
-		);
+		_options = Options{};
+		_app.clear();
 
-		plg::print(DOUBLE_LINE);
+		// Parse arguments
+		try {
+			_app.parse(args.ArgC(), args.ArgV());
+		} catch (const CLI::ParseError& e) {
+			_capture.reset();
+			std::stringstream out;
+			std::stringstream err;
+			_app.exit(e, out, err);
+			if (auto output = out.str(); !output.empty()) {
+				plg::print(std::move(output));
+			}
+			if (auto error = err.str(); !error.empty()) {
+				plg::print(std::move(error));
+			}
+		}
+
+		if (_capture) {
+			_capture.reset();
+			WriteReportFile(_options.output, _captured);
+			_captured = {};
+		}
 	}
+
+	CLI::App _app{ "Plugify Management System" };
+	Options _options;
+	std::string _captured;
+	std::optional<OutputCapture> _capture;
 };
 
 // Main command handler using CLI11
 CON_COMMAND_F(plugify, "Plugify control options", FCVAR_NONE) {
+	RuntimeTraceScope commandTrace("plugify", "console", args.ArgC());
+	ConsoleProbe probe(args);
+
 	if (!s_plugify || !s_plugify->IsInitialized()) {
 		plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
 		return;
 	}
 
-	// Create a temporary CLI app for parsing
-	CLI::App app{ "Plugify Management System" };
-	app.require_subcommand();  // 1 or more
-	// interactiveApp.allow_extras();
-	// interactiveApp.prefix_command();
-	app.set_version_flag("-v,--version", GetVersionString());
-	app.usage("Usage: plugify <command> [options]");
-	// flag to display full help at once
-	app.set_help_flag();
-	app.set_help_all_flag("-h, --help", "Print this help message and exit");
-
-	// Global options
-	bool jsonOutput = false;
-
-	app.add_flag("-j,--json", jsonOutput, "Output in JSON format");
-
-	// Add all commands (similar to main but simplified)
-	auto* load = app.add_subcommand("load", "Load manager");
-	auto* unload = app.add_subcommand("unload", "Unload manager");
-	auto* reload = app.add_subcommand("reload", "Reload manager");
-	auto* plugins = app.add_subcommand("plugins", "List plugins");
-	auto* modules = app.add_subcommand("modules", "List modules");
-	// Show plugin/module commands
-	auto* plugin = app.add_subcommand("plugin", "Show plugin information");
-	auto* module = app.add_subcommand("module", "Show module information");
-	auto* health = app.add_subcommand("health", "System health");
-	auto* tree = app.add_subcommand("tree", "Show dependency tree");
-	auto* search = app.add_subcommand("search", "Search extensions");
-	auto* validate = app.add_subcommand("validate", "Validate extension file");
-	auto* compare = app.add_subcommand("compare", "Compare two extensions");
-
-	// Enhanced list commands with filters and sorting
-	std::string pluginFilterState;
-	std::string pluginFilterLang;
-	std::string pluginSortBy = "name";
-	bool pluginReverse = false;
-	bool pluginShowFailed = false;
-
-	plugins->add_option(
-	    "--filter-state",
-	    pluginFilterState,
-	    "Filter by state (comma-separated: loaded,failed,disabled)"
-	);
-	plugins->add_option(
-	    "--filter-lang",
-	    pluginFilterLang,
-	    "Filter by language (comma-separated: cpp,python,rust)"
-	);
-	plugins
-	    ->add_option("-s,--sort", pluginSortBy, "Sort by: name, version, state, language, loadtime")
-	    ->check(CLI::IsMember({ "name", "version", "state", "language", "loadtime" }));
-	plugins->add_flag("-r,--reverse", pluginReverse, "Reverse sort order");
-	plugins->add_flag("-f,--failed", pluginShowFailed, "Show only failed plugins");
-
-	std::string moduleFilterState;
-	std::string moduleFilterLang;
-	std::string moduleSortBy = "name";
-	bool moduleReverse = false;
-	bool moduleShowFailed = false;
-
-	modules->add_option("--filter-state", moduleFilterState, "Filter by state (comma-separated)");
-	modules->add_option("--filter-lang", moduleFilterLang, "Filter by language (comma-separated)");
-	modules
-	    ->add_option("-s,--sort", moduleSortBy, "Sort by: name, version, state, language, loadtime")
-	    ->check(CLI::IsMember({ "name", "version", "state", "language", "loadtime" }));
-	modules->add_flag("-r,--reverse", moduleReverse, "Reverse sort order");
-	modules->add_flag("-f,--failed", moduleShowFailed, "Show only failed modules");
-
-	// Add options for plugin/module
-	std::string plugin_name;
-	bool plugin_use_id = false;
-	plugin->add_option("name", plugin_name, "Plugin name or ID")->required();
-	plugin->add_flag("-u,--uuid", plugin_use_id, "Use ID instead of name");
-	plugin->validate_positionals();
-
-	std::string module_name;
-	bool module_use_id = false;
-	module->add_option("name", module_name, "Module name or ID")->required();
-	module->add_flag("-u,--uuid", module_use_id, "Use ID instead of name");
-	module->validate_positionals();
-
-	std::string tree_name;
-	bool tree_use_id = false;
-	tree->add_option("name", tree_name, "Extension name or ID")->required();
-	tree->add_flag("-u,--uuid", tree_use_id, "Use ID instead of name");
-	tree->validate_positionals();
-
-	std::string search_query;
-	search->add_option("query", search_query, "Search query")->required();
-	search->validate_positionals();
-
-	std::string validate_path;
-	validate->add_option("path", validate_path, "Path to extension file")->required();
-	validate->validate_positionals();
-
-	std::string compare_ext1, compare_ext2;
-	bool compare_use_id = false;
-	compare->add_option("extension1", compare_ext1, "First extension")->required();
-	compare->add_option("extension2", compare_ext2, "Second extension")->required();
-	compare->add_flag("-u,--uuid", compare_use_id, "Use ID instead of name");
-	compare->validate_positionals();
-
-	// Set callbacks
-	load->callback([]() { LoadManager(); });
-	unload->callback([]() { UnloadManager(); });
-	reload->callback([]() { ReloadManager(); });
-
-	plugins->callback([&pluginFilterState,  &pluginFilterLang, &pluginShowFailed, &pluginSortBy, &pluginReverse, &jsonOutput]() {
-		FilterOptions filter;
-		if (!pluginFilterState.empty()) {
-			filter.states = ParseStates(ParseCsv(pluginFilterState));
-		}
-		if (!pluginFilterLang.empty()) {
-			filter.languages = ParseCsv(pluginFilterLang);
-		}
-		filter.showOnlyFailed = pluginShowFailed;
-
-		ListPlugins(filter, ParseSortBy(pluginSortBy), pluginReverse, jsonOutput);
-	});
-
-	modules->callback([&moduleFilterState, &moduleFilterLang, &moduleShowFailed, &moduleSortBy, &moduleReverse, &jsonOutput]() {
-		FilterOptions filter;
-		if (!moduleFilterState.empty()) {
-			filter.states = ParseStates(ParseCsv(moduleFilterState));
-		}
-		if (!moduleFilterLang.empty()) {
-			filter.languages = ParseCsv(moduleFilterLang);
-		}
-		filter.showOnlyFailed = moduleShowFailed;
-
-		ListModules(filter, ParseSortBy(moduleSortBy), moduleReverse, jsonOutput);
-	});
-
-	plugin->callback([&plugin_name, &plugin_use_id, &jsonOutput]() {
-		ShowPlugin(plugin_name, plugin_use_id, jsonOutput);
-	});
-
-	module->callback([&module_name, &module_use_id, &jsonOutput]() {
-		ShowModule(module_name, module_use_id, jsonOutput);
-	});
-
-	health->callback([]() { ShowHealth(); });
-
-	tree->callback([&tree_name, &tree_use_id]() { ShowDependencyTree(tree_name, tree_use_id); });
-
-	search->callback([&search_query]() {
-		if (!search_query.empty()) {
-			SearchExtensions(search_query);
-		} else {
-			plg::print("Search query required");
-		}
-	});
-
-	validate->callback([&validate_path]() { ValidateExtension(validate_path); });
-
-	compare->callback([&compare_ext1, &compare_ext2, &compare_use_id]() {
-		CompareExtensions(compare_ext1, compare_ext2, compare_use_id);
-	});
-
-	// Parse arguments
-	try {
-		app.parse(args.ArgC(), args.ArgV());
-	} catch (const CLI::ParseError& e) {
-		std::stringstream out;
-		std::stringstream err;
-		app.exit(e, out, err);
-		if (auto output = out.str(); !output.empty()) {
-			plg::print(std::move(output));
-		}
-		if (auto error = err.str(); !error.empty()) {
-			plg::print(std::move(error));
-		}
-	}
+	CommandArena::Scope arena;
+	PlugifyCommandLine::Execute(args);
 }
 
 // Alternative shorter command
@@ -2353,22 +5856,74 @@ static ConCommand plg_command("plg", plugify_callback, "Plugify control options"
 static ConCommand pkg_command("plug", plugify_callback, "Micromamba control options", 0);
 
 CON_COMMAND_F(micromamba, "Micromamba control options", FCVAR_NONE) {
+	RuntimeTraceScope commandTrace("micromamba", "console", args.ArgC());
+	ConsoleProbe probe(args);
+
 	if (!s_plugify || !s_plugify->IsInitialized()) {
 		plg::print("{}: Initialize system before use.", Colorize("Error", Colors::RED));
 		return;
 	}
 
-	if (s_plugify->GetManager().IsInitialized()) {
+	std::span arguments(args.ArgV(), static_cast<size_t>(args.ArgC()));
+
+	// Job control is handled by the launcher, not micromamba
+	if (arguments.size() >= 2 && std::string_view(arguments[1]) == "jobs") {
+		ShowMambaJobs();
+		return;
+	}
+	if (arguments.size() >= 2 && std::string_view(arguments[1]) == "cancel") {
+		uint64_t id = 0;
+		std::string_view value = arguments.size() >= 3 ? arguments[2] : "";
+		if (std::from_chars(value.data(), value.data() + value.size(), id).ec != std::errc{}) {
+			plg::print("Usage: {} cancel <id>", Colorize("micromamba", Colors::CYAN));
+		} else if (MambaJobs::Cancel(id)) {
+			plg::print("{}: Cancelling job #{}", Colorize("Info", Colors::BLUE), id);
+		} else {
+			plg::print("{}: Job #{} is not running.", Colorize("Error", Colors::RED), id);
+		}
+		return;
+	}
+
+	// Strip the launcher-only options: --stage, --no-cache and --timeout <seconds>
+	std::vector<std::string_view> params;
+	params.reserve(arguments.size());
+	MambaJobs::Options options;
+	bool staged = false;
+	bool useCache = true;
+	for (size_t i = 0; i < arguments.size(); ++i) {
+		std::string_view arg = arguments[i];
+		if (i > 0 && arg == "--stage") {
+			staged = true;
+			continue;
+		}
+		if (i > 0 && arg == "--no-cache") {
+			useCache = false;
+			continue;
+		}
+		if (i > 0 && arg == "--timeout" && i + 1 < arguments.size()) {
+			int seconds = 0;
+			std::string_view value = arguments[++i];
+			if (std::from_chars(value.data(), value.data() + value.size(), seconds).ec == std::errc{}) {
+				options.timeout = std::chrono::seconds(std::max(seconds, 0));
+			}
+			continue;
+		}
+		params.push_back(arg);
+	}
+
+	if (!staged && s_plugify->GetManager().IsInitialized()) {
 		plg::print(
 			"{}: Package operations are only allowed when plugin manager is unloaded\n"
-			"Please run 'plugify unload' first.",
+			"Please run 'plugify unload' first, or stage the change with '--stage' and apply it with 'plugify swap'.",
 			Colorize("Error", Colors::RED));
 		return;
 	}
 
-	std::span arguments(args.ArgV(), static_cast<size_t>(args.ArgC()));
-	if (arguments.size() < 2) {
-		plg::print("Usage: {} <command> [options]", Colorize("micromamba", Colors::CYAN));
+	if (params.size() < 2) {
+		plg::print(
+		    "Usage: {} [--stage] [--no-cache] [--timeout <seconds>] <command> [options]",
+		    Colorize("micromamba", Colors::CYAN)
+		);
 		return;
 	}
 
@@ -2383,11 +5938,11 @@ CON_COMMAND_F(micromamba, "Micromamba control options", FCVAR_NONE) {
 	}
 
 	std::vector<std::string> cmd;
-	cmd.reserve(arguments.size() * 2);
+	cmd.reserve(params.size() * 2);
 	cmd.push_back(plg::as_string(exePath));
 
 	// Check for specific commands that might need special handling
-	std::string_view command = arguments[1];
+	std::string_view command = params[1];
 
 	// Block shell injection
 	if (command == "shell") {
@@ -2398,30 +5953,51 @@ CON_COMMAND_F(micromamba, "Micromamba control options", FCVAR_NONE) {
 		return;
 	}
 
-	static std::string envName;
 	if (command == "activate") {
-		if (arguments.size() < 2) {
+		if (params.size() < 3) {
 			plg::print("Usage: {} activate <command> [options]", Colorize("micromamba", Colors::CYAN));
 			return;
 		}
-		envName = arguments[2];
-		plg::print("You activate environment: {}", Colorize(envName, Colors::CYAN));
+		s_mambaEnv = params[2];
+		plg::print("You activate environment: {}", Colorize(s_mambaEnv, Colors::CYAN));
 		return;
 	}
 
-	// Add all arguments
-	for (int i = 1; i < arguments.size(); ++i) {
-		cmd.emplace_back(arguments[i]);
-	}
-
 	bool has_yes = false;
 	bool has_root = false;
 	bool has_name = false;
+	bool has_prefix = false;
 	bool has_help = false;
+	std::string envName = s_mambaEnv;
+	fs::path explicitPrefix;
+
+	// Add all arguments, noting the target environment for the query cache and the job's prefix
+	// claim. A staged run targets staging/<env> by prefix instead of by name.
+	for (size_t i = 1; i < params.size(); ++i) {
+		std::string_view arg = params[i];
+		if (i >= 2 && (arg == "-n" || arg == "--name" || arg.starts_with("--name="))) {
+			has_name = true;
+			bool inlineValue = arg.starts_with("--name=");
+			if (inlineValue || i + 1 < params.size()) {
+				envName = inlineValue ? arg.substr(7) : params[i + 1];
+				if (staged) {
+					i += inlineValue ? 0 : 1;
+					continue;
+				}
+			}
+		} else if (i >= 2 && (arg == "-p" || arg == "--prefix" || arg.starts_with("--prefix="))) {
+			has_prefix = true;
+			bool inlineValue = arg.starts_with("--prefix=");
+			if (inlineValue || i + 1 < params.size()) {
+				explicitPrefix = fs::absolute(inlineValue ? arg.substr(9) : params[i + 1], ec);
+			}
+		}
+		cmd.emplace_back(arg);
+	}
 
 	// Special handling ensure some flag for non-interactive
-	for (int i = 2; i < arguments.size(); ++i) {
-		std::string_view arg = arguments[i];
+	for (size_t i = 2; i < params.size(); ++i) {
+		std::string_view arg = params[i];
 		if (arg == "-y" || arg == "--yes") {
 			has_yes = true;
 			continue;
@@ -2430,10 +6006,6 @@ CON_COMMAND_F(micromamba, "Micromamba control options", FCVAR_NONE) {
 			has_root = true;
 			continue;
 		}
-		if (arg == "-n" || arg == "--name") {
-			has_name = true;
-			continue;
-		}
 		if (arg == "-h" || arg == "--help") {
 			has_help = true;
 			continue;
@@ -2446,109 +6018,380 @@ CON_COMMAND_F(micromamba, "Micromamba control options", FCVAR_NONE) {
 		cmd.emplace_back("-r");  // Add -r path
 		cmd.push_back(plg::as_string(baseDir));
 	}
-	if (!has_name && !has_help) {
+
+	fs::path prefix = has_prefix ? explicitPrefix : EnvironmentDir(envName);
+	if (staged) {
+		if (has_prefix) {
+			plg::print("{}: --stage picks the prefix itself, pass -n instead of -p.", Colorize("Error", Colors::RED));
+			return;
+		}
+		if (envName.empty()) {
+			plg::print("{}: Staging needs an environment, run 'mamba activate <env>' or pass -n.", Colorize("Error", Colors::RED));
+			return;
+		}
+
+		auto stagedDir = StagingDir() / envName;
+		prefix = stagedDir;
+		cmd.emplace_back("-p");  // Add -p staged prefix
+		cmd.push_back(plg::as_string(stagedDir));
+		plg::print("Staging environment: {}", Colorize(plg::as_string(stagedDir), Colors::CYAN));
+
+		// First staged job seeds the shadow copy from the live environment, off the game thread
+		options.prepare = [live = EnvironmentDir(envName), stagedDir]() -> Result<void> {
+			std::error_code ec;
+			if (fs::exists(stagedDir, ec) || !fs::exists(live, ec)) {
+				return {};
+			}
+			fs::create_directories(stagedDir.parent_path(), ec);
+			fs::copy(live, stagedDir, fs::copy_options::recursive | fs::copy_options::copy_symlinks, ec);
+			if (ec) {
+				return MakeError("Failed to seed staged environment: {}", ec.message());
+			}
+			return {};
+		};
+		options.complete = RelocateStagedJob(stagedDir, EnvironmentDir(envName));
+	} else if (!has_name && !has_prefix && !has_help) {
 		if (command == "install" || command == "update" || command == "repoquery" || command == "remove"
 		    || command == "uninstall" || command == "list" || command == "search") {
 			cmd.emplace_back("-n");  // Add -n name
 			cmd.push_back(envName);
 
-			plg::print("Current environment: {}", Colorize(envName, Colors::CYAN));
+			plg::print("Current environment: {}", Colorize(envName, Colors::CYAN));
+		}
+	}
+
+	std::string label = std::string(command);
+	for (size_t i = 2; i < cmd.size(); ++i) {
+		std::format_to(std::back_inserter(label), " {}", cmd[i]);
+	}
+
+	// Repeat queries are answered from the cache while nothing on disk has changed
+	if (MambaQueryCache::IsQuery(command) && !has_help) {
+		auto stamp = MambaQueryCache::Fingerprint(baseDir, prefix);
+		if (useCache) {
+			if (auto hit = MambaQueryCache::Find(label, stamp)) {
+				for (const auto& line : hit->lines) {
+					plg::print("{} {}", Colorize("[mamba cache]", Colors::GRAY), line);
+				}
+				plg::print(
+				    "{} {}",
+				    Colorize("[mamba cache]", Colors::GRAY),
+				    Colorize(
+				        std::format(
+				            "Served from cache ({} old), pass --no-cache to refresh.",
+				            FormatDuration(std::chrono::duration_cast<std::chrono::microseconds>(hit->age))
+				        ),
+				        Colors::GREEN
+				    )
+				);
+				return;
+			}
+		}
+		options.capture = [key = label, stamp](std::vector<std::string> lines) {
+			MambaQueryCache::Store(std::move(key), stamp, std::move(lines));
+		};
+	} else if (!has_help) {
+		// Anything else may change an environment
+		MambaQueryCache::Clear();
+		options.prefix = prefix;
+	}
+
+	// Execute in the background, output is streamed as it arrives
+	auto id = MambaJobs::Launch(std::move(cmd), std::move(label), std::move(options));
+	if (!id) {
+		plg::print("{}: {}", Colorize("Error", Colors::RED), id.error());
+		return;
+	}
+	plg::print(
+	    "{}: Started job #{}, use '{}' to list or '{}' to stop it.",
+	    Colorize("Info", Colors::BLUE),
+	    *id,
+	    Colorize("mamba jobs", Colors::CYAN),
+	    Colorize(std::format("mamba cancel {}", *id), Colors::CYAN)
+	);
+	if (staged) {
+		plg::print("Run '{}' once it completes to apply the change.", Colorize("plugify swap", Colors::CYAN));
+	}
+}
+
+// Alternative shorter command
+static ConCommand mamba_command("mamba", micromamba_callback, "Micromamba control options", 0);
+static ConCommand conda_command("conda", micromamba_callback, "Micromamba control options", 0);
+
+// Replays a recorded console stream in the headless harness (--plugify-replay <file>, with
+// --plugify-replay-speed and --plugify-replay-repeat). It is deliberately not reachable from the
+// console: recorded unload/reload and mamba install/remove lines would run against the live
+// manager and environments. Commands are issued from the game thread at their recorded offsets
+// scaled by the speed factor, or one per tick at speed 0, and handler latency is grouped per
+// subcommand.
+class CommandReplay {
+public:
+	using Handler = void (*)(const CCommandContext&, const CCommand&);
+
+	// Picked up by the first tick after Plugify is initialized
+	static void Queue(fs::path path, double speed, int repeat) {
+		_pending = std::move(path);
+		_pendingSpeed = speed;
+		_pendingRepeat = repeat;
+	}
+
+	static Result<size_t> Start(const fs::path& path, double speed, int repeat) {
+		if (_running) {
+			return MakeError("A replay is already running");
+		}
+		auto commands = LoadCommandLog(path);
+		if (!commands) {
+			return MakeError(std::move(commands.error()));
+		}
+
+		// Recording control would nest or end the run
+		std::erase_if(*commands, [](const RecordedCommand& command) {
+			return CommandKey(command.line) == "plugify record";
+		});
+		if (commands->empty()) {
+			return MakeError("No replayable commands in {}", plg::as_string(path));
+		}
+
+		_commands = std::move(*commands);
+		_path = path;
+		_speed = speed;
+		_remaining = std::max(repeat, 1);
+		_next = 0;
+		_samples.clear();
+		_samples.reserve(_commands.size() * static_cast<size_t>(_remaining));
+		_origin = std::chrono::steady_clock::now();
+		_running = true;
+		return _commands.size();
+	}
+
+	static bool IsRunning() {
+		return _running;
+	}
+
+	static void Tick() {
+		if (!_pending.empty()) {
+			auto path = std::exchange(_pending, {});
+			if (auto result = Start(path, _pendingSpeed, _pendingRepeat); !result) {
+				plg::print("{}: {}", Colorize("Error", Colors::RED), result.error());
+			} else {
+				plg::print("{}: Replaying {} commands from {}", Colorize("Info", Colors::BLUE), *result, plg::as_string(path));
+			}
+		}
+		if (!_running) {
+			return;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		while (_next < _commands.size()) {
+			const auto& command = _commands[_next];
+			if (_speed > 0.0) {
+				auto due = _origin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				    std::chrono::duration<double, std::micro>(static_cast<double>(command.offset_us) / _speed)
+				);
+				if (due > now) {
+					break;
+				}
+			}
+			Execute(command.line);
+			++_next;
+			if (_speed <= 0.0) {
+				break;
+			}
+		}
+
+		if (_next == _commands.size()) {
+			if (--_remaining > 0) {
+				_next = 0;
+				_origin = std::chrono::steady_clock::now();
+			} else {
+				Finish();
+			}
+		}
+	}
+
+private:
+	static Handler FindHandler(std::string_view name) {
+		if (name == "plugify" || name == "plg" || name == "plug") {
+			return &plugify_callback;
+		}
+		if (name == "mamba" || name == "conda" || name == "micromamba") {
+			return &micromamba_callback;
+		}
+		return nullptr;
+	}
+
+	static void Execute(const std::string& line) {
+		CCommand args;
+		if (!args.Tokenize(line.c_str()) || args.ArgC() == 0) {
+			return;
+		}
+		auto handler = FindHandler(args.Arg(0));
+		if (!handler) {
+			return;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		handler(CCommandContext(CT_NO_TARGET, CPlayerSlot(0)), args);
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		_samples.emplace_back(CommandKey(line), elapsed.count());
+	}
+
+	static void Finish() {
+		_running = false;
+
+		std::vector<std::pair<std::string, int64_t>> recorded;
+		recorded.reserve(_commands.size());
+		for (const auto& command : _commands) {
+			recorded.emplace_back(CommandKey(command.line), command.latency_us);
+		}
+		std::unordered_map<std::string, int64_t> baseline;
+		for (const auto& summary : SummarizeLatencies(std::move(recorded))) {
+			baseline.emplace(summary.key, summary.p50_us);
+		}
+
+		auto summaries = SummarizeLatencies(std::move(_samples));
+		_samples = {};
+
+		plg::print(Colorize("Command Replay:", Colors::CYAN));
+		plg::print(SEPARATOR_LINE);
+		plg::print(
+		    "{:<24} {:>6} {:>10} {:>10} {:>10} {:>10} {:>12}",
+		    "Command", "Count", "p50", "p90", "p99", "Max", "Recorded p50"
+		);
+		plg::print(SEPARATOR_LINE);
+		glz::json_t::array_t rows;
+		for (const auto& summary : summaries) {
+			auto it = baseline.find(summary.key);
+			auto recordedP50 = it != baseline.end() ? it->second : 0;
+			plg::print(
+			    "{:<24} {:>6} {:>10} {:>10} {:>10} {:>10} {:>12}",
+			    summary.key,
+			    summary.count,
+			    FormatDuration(std::chrono::microseconds(summary.p50_us)),
+			    FormatDuration(std::chrono::microseconds(summary.p90_us)),
+			    FormatDuration(std::chrono::microseconds(summary.p99_us)),
+			    FormatDuration(std::chrono::microseconds(summary.max_us)),
+			    FormatDuration(std::chrono::microseconds(recordedP50))
+			);
+
+			glz::json_t row;
+			row["command"] = summary.key;
+			row["count"] = static_cast<double>(summary.count);
+			row["p50_us"] = static_cast<double>(summary.p50_us);
+			row["p90_us"] = static_cast<double>(summary.p90_us);
+			row["p99_us"] = static_cast<double>(summary.p99_us);
+			row["max_us"] = static_cast<double>(summary.max_us);
+			row["recorded_p50_us"] = static_cast<double>(recordedP50);
+			rows.emplace_back(std::move(row));
 		}
-	}
+		plg::print(SEPARATOR_LINE);
 
-	// Execute
-	reproc::process process;
-	reproc::options options;
-	options.env.behavior = reproc::env::extend;
+		glz::json_t report;
+		report["source"] = plg::as_string(_path);
+		report["speed"] = _speed;
+		report["commands"] = glz::json_t::array_t{ std::move(rows) };
 
-	ec = process.start(cmd, options);
-	if (ec) {
-		plg::print("{}: Failed to start {} - {}", Colorize("Error", Colors::RED), Colorize("micromamba", Colors::CYAN), ec.message());
-		return;
+		auto path = fs::path(Plat_GetGameDirectory()) / BASE_PATH / "logs" / FormatFileName("replay", "json");
+		std::error_code ec;
+		fs::create_directories(path.parent_path(), ec);
+		if (std::ofstream file(path, std::ios::binary); file) {
+			file << *report.dump();
+			plg::print("{}: Replay report written to {}", Colorize("Success", Colors::GREEN), plg::as_string(path));
+		} else {
+			plg::print("{}: Failed to write replay report {}", Colorize("Warning", Colors::YELLOW), plg::as_string(path));
+		}
 	}
 
-	std::string output, error;
-	reproc::sink::string sink_out(output);
-	reproc::sink::string sink_err(error);
+	inline static fs::path _pending;
+	inline static double _pendingSpeed{};
+	inline static int _pendingRepeat{ 1 };
+	inline static fs::path _path;
+	inline static std::vector<RecordedCommand> _commands;
+	inline static std::vector<std::pair<std::string, int64_t>> _samples;
+	inline static std::chrono::steady_clock::time_point _origin;
+	inline static size_t _next{};
+	inline static int _remaining{};
+	inline static double _speed{};
+	inline static bool _running{ false };
+};
 
-	// Real-time output streaming
-	ec = reproc::drain(process, sink_out, sink_err);
-	if (ec) {
-		plg::print("{}: Failed to read output - {}", Colorize("Error", Colors::RED), ec.message());
-		return;
-	}
+std::unique_ptr<DynLibUtils::CModule> s_server;
+DynLibUtils::CVTFHookAuto<&IGameSystem::ServerGamePostSimulate> s_ServerGamePostSimulate;
 
-	auto [status, wait_ec] = process.wait(reproc::infinite);
-	if (wait_ec) {
-		plg::print("{}: Process wait error - {}", Colorize("Error", Colors::RED), wait_ec.message());
-		return;
-	} else if (status != 0) {
-		plg::print("{}: Process exited with code - {}", Colorize("Error", Colors::RED), status);
-		return;
+// Records the duration of each tick in the flight recorder
+struct FlightTickScope {
+	~FlightTickScope() {
+		FlightRecorder::Tick(
+		    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+		);
 	}
 
-	if (!output.empty()) {
-		plg::print(std::move(output));
-	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
 
-	if (!error.empty()) {
-		plg::print(std::move(error));
-	}
-}
+void ServerGamePostSimulate(IGameSystem* pThis, const EventServerGamePostSimulate_t& msg) {
+	RuntimeTraceScope trace("Tick", "tick");
+	FlightTickScope flight;
 
-// Alternative shorter command
-static ConCommand mamba_command("mamba", micromamba_callback, "Micromamba control options", 0);
-static ConCommand conda_command("conda", micromamba_callback, "Micromamba control options", 0);
+	static uint64_t tick = 0;
+	++tick;
+	S2_PROBE1(tick__begin, tick);
 
-std::unique_ptr<DynLibUtils::CModule> s_server;
-DynLibUtils::CVTFHookAuto<&IGameSystem::ServerGamePostSimulate> s_ServerGamePostSimulate;
+	Watchdog::TickScope watchdog;
 
-void ServerGamePostSimulate(IGameSystem* pThis, const EventServerGamePostSimulate_t& msg) {
 	s_ServerGamePostSimulate.Call(pThis, msg);
 
 	if (!s_plugify) {
+		S2_PROBE1(tick__end, tick);
 		return;
 	}
 
-	s_plugify->Update();
-
-	switch (s_state) {
-		case PlugifyState::Load: {
-			auto& manager = s_plugify->GetManager();
-			if (auto initResult = manager.Initialize()) {
-				plg::print("{}: Plugin manager was loaded.", Colorize("Success", Colors::GREEN));
-			} else {
-				plg::print("{}: {}", Colorize("Error", Colors::RED), initResult.error());
-			}
-			break;
-		}
-		case PlugifyState::Unload: {
-			auto& manager = s_plugify->GetManager();
-			manager.Terminate();
-			plg::print("{}: Plugin manager was unloaded.", Colorize("Success", Colors::GREEN));
-			break;
+	{
+		RuntimeTraceScope update("Update", "plugify");
+#if S2_PLATFORM_LINUX
+		bool counting = PerfCounters::IsOpen();
+		if (counting) {
+			PerfCounters::BeginTick();
 		}
-		case PlugifyState::Reload: {
-			auto& manager = s_plugify->GetManager();
-			manager.Terminate();
-			if (auto initResult = manager.Initialize()) {
-				plg::print("{}: Plugin manager was reloaded.", Colorize("Success", Colors::GREEN));
-			} else {
-				plg::print("{}: {}", Colorize("Error", Colors::RED), initResult.error());
-			}
-			break;
+#endif
+		s_plugify->Update();
+#if S2_PLATFORM_LINUX
+		if (counting) {
+			PerfCounters::EndTick();
 		}
-		case PlugifyState::Wait:
-			return;
+#endif
 	}
 
-	s_state = PlugifyState::Wait;
+	auto launcherStart = std::chrono::steady_clock::now();
+	DrainCommands();
+	TaskPool::DrainMain();
+	CommandReplay::Tick();
+	ConsolePager::Tick();
+	HostBench::Tick(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - launcherStart));
+
+	if (RuntimeTrace::IsEnabled() && RuntimeTrace::Expired()) {
+		StopRuntimeTrace();
+	}
+
+	S2_PROBE1(tick__end, tick);
 }
 
 static constexpr auto RWX_PERMS = fs::perms::owner_all | fs::perms::group_read | fs::perms::group_exec
                                   | fs::perms::others_read | fs::perms::others_exec;
 
 class CrashpadInitializer {
+	struct WatchdogMetadata {
+		std::optional<int> stall_ms;
+		std::optional<int> abort_ms;
+		std::optional<bool> dump;
+	};
+
+	struct TaskMetadata {
+		std::optional<uint32_t> threads;
+		std::optional<std::vector<uint32_t>> affinity;
+		std::optional<int> budget_us;
+	};
+
 	struct Metadata {
 		std::string url;
 		std::string handlerApp;
@@ -2562,8 +6405,26 @@ class CrashpadInitializer {
 		std::optional<bool> asynchronous_start;
 		std::optional<bool> listen_console;
 		std::optional<bool> enabled;
+		std::optional<WatchdogMetadata> watchdog;
+		std::optional<uint32_t> flight_records;
+		std::optional<TaskMetadata> tasks;
+	};
+
+public:
+	struct Timings {
+		std::chrono::microseconds metadata{};
+		std::chrono::microseconds handler{};
+		std::chrono::microseconds directories{};
+		std::chrono::microseconds database{};
+		std::chrono::microseconds logging{};
+		std::chrono::microseconds start{};
+		std::chrono::microseconds total{};       // handler startup, off-thread when async
+		std::chrono::microseconds engineLoad{};  // engine2 load running alongside it
+		std::chrono::microseconds wait{};        // time main() blocked on Wait()
+		bool async = false;
 	};
 
+private:
 	static Result<fs::path> ValidateHandler(const fs::path& exeDir, std::string_view handlerName) {
 		fs::path handlerPath = exeDir / std::format(S2_EXECUTABLE_PREFIX "{}" S2_EXECUTABLE_SUFFIX, handlerName);
 
@@ -2623,27 +6484,66 @@ class CrashpadInitializer {
 		return std::move(*listener);
 	}
 
-public:
-	static Result<std::unique_ptr<CrashpadClient>>
-	Initialize(const fs::path& exeDir, const fs::path& annotationsPath) {
-		// Load metadata
-		auto metadataResult = ReadJson<Metadata>(exeDir / annotationsPath);
-		if (!metadataResult) {
-			return MakeError("Failed to load metadata: {}", metadataResult.error());
+	// Every start maps a new flight-<timestamp>.bin, only the most recent ones are kept. The
+	// timestamp in the name sorts chronologically.
+	static void PruneFlightFiles(const fs::path& logsDir) {
+		constexpr size_t kKeepFiles = 8;
+
+		std::error_code ec;
+		std::vector<fs::path> files;
+		for (const auto& entry : fs::directory_iterator(logsDir, ec)) {
+			auto name = entry.path().filename().string();
+			if (entry.is_regular_file(ec) && name.starts_with("flight-") && name.ends_with(".bin")) {
+				files.push_back(entry.path());
+			}
+		}
+		if (files.size() < kKeepFiles) {
+			return;
+		}
+
+		// Leaves room for the file about to be created
+		std::ranges::sort(files);
+		for (const auto& file : std::span(files).first(files.size() - kKeepFiles + 1)) {
+			fs::remove(file, ec);
 		}
+	}
 
-		const auto& metadata = *metadataResult;
+	// Opened before the handler so every event from engine startup onward lands in the report
+	static void SetupFlightRecorder(const fs::path& exeDir, const Metadata& metadata) {
+		auto capacity = metadata.flight_records.value_or(FlightRecorder::kDefaultCapacity);
 
-		// Check if crashpad is enabled
-		if (!metadata.enabled.value_or(false)) {
-			return nullptr;
+		fs::path path;
+		if (metadata.enabled.value_or(false)) {
+			path = exeDir / metadata.logsDir / FormatFileName("flight", "bin");
+			PruneFlightFiles(path.parent_path());
+		}
+
+		if (auto result = FlightRecorder::Open(path, capacity); !result) {
+			std::println(std::cerr, "Flight recorder error: {}", result.error());
+			// Keep recording in memory so the live decoder still works
+			(void) FlightRecorder::Open({}, capacity);
 		}
+	}
+
+	static Result<std::unique_ptr<CrashpadClient>>
+	Start(const fs::path& exeDir, const Metadata& metadata, Timings& timings) {
+		using namespace std::chrono;
+
+		TraceScope scope("Crashpad::Start");
+
+		auto begin = steady_clock::now();
+		auto lap = [last = begin](microseconds& out) mutable {
+			auto now = steady_clock::now();
+			out = duration_cast<microseconds>(now - last);
+			last = now;
+		};
 
 		// Validate handler executable
 		auto handlerResult = ValidateHandler(exeDir, metadata.handlerApp);
 		if (!handlerResult) {
 			return MakeError(std::move(handlerResult.error()));
 		}
+		lap(timings.handler);
 
 		// Setup directories
 		auto databaseResult = EnsureDirectory(exeDir / metadata.databaseDir, "database");
@@ -2655,6 +6555,7 @@ public:
 		if (!metricsResult) {
 			return MakeError(std::move(metricsResult.error()));
 		}
+		lap(timings.directories);
 
 		// Initialize database
 		base::FilePath databaseDir(*databaseResult);
@@ -2665,6 +6566,7 @@ public:
 
 		// Configure upload settings
 		database->GetSettings()->SetUploadsEnabled(!metadata.url.empty());
+		lap(timings.database);
 
 		// Prepare attachments
 		std::vector<base::FilePath> attachments;
@@ -2674,6 +6576,13 @@ public:
 			attachments.emplace_back(exeDir / attachment);
 		}
 
+		// Attach the flight recorder ring
+		if (const auto& flightPath = FlightRecorder::GetPath(); !flightPath.empty()) {
+			fs::path attachmentPath = "flight.bin=";
+			attachmentPath += fs::path(flightPath).make_preferred();
+			attachments.emplace_back(attachmentPath);
+		}
+
 		// Setup console logging if requested
 		if (metadata.listen_console.value_or(false)) {
 			auto listenerResult = SetupConsoleLogging(exeDir, metadata.logsDir, attachments);
@@ -2683,8 +6592,10 @@ public:
 				s_listener = std::move(*listenerResult);
 			}
 		}
+		lap(timings.logging);
 
-		// Start crash handler
+		// Start crash handler. Only the Windows client supports an asynchronous handler launch,
+		// elsewhere asynchronous_start is honoured by running this whole function off-thread.
 		auto client = std::make_unique<CrashpadClient>();
 		bool started = client->StartHandler(
 		    base::FilePath(*handlerResult),
@@ -2694,16 +6605,104 @@ public:
 		    metadata.annotations,
 		    metadata.arguments,
 		    metadata.restartable.value_or(false),
-		    metadata.asynchronous_start.value_or(false),
+		    S2_PLATFORM_WINDOWS && metadata.asynchronous_start.value_or(false),
 		    attachments
 		);
 
 		if (!started) {
 			return MakeError("Failed to start Crashpad handler");
 		}
+		lap(timings.start);
 
+		timings.total = duration_cast<microseconds>(steady_clock::now() - begin);
 		return client;
 	}
+
+	inline static std::future<Result<std::unique_ptr<CrashpadClient>>> s_pending;
+	inline static Timings s_timings;
+	inline static Watchdog::Options s_watchdog;
+	inline static TaskPool::Options s_tasks;
+
+public:
+	// Read the configuration and start the handler, on a background thread
+	// when asynchronous_start is set. Call Wait() before a handler is required.
+	static Result<void> Launch(const fs::path& exeDir, const fs::path& annotationsPath) {
+		using namespace std::chrono;
+
+		auto begin = steady_clock::now();
+
+		// Load metadata
+		auto metadataResult = ReadJson<Metadata>(exeDir / annotationsPath);
+		if (!metadataResult) {
+			return MakeError("Failed to load metadata: {}", metadataResult.error());
+		}
+
+		s_timings.metadata = duration_cast<microseconds>(steady_clock::now() - begin);
+
+		SetupFlightRecorder(exeDir, *metadataResult);
+
+		if (const auto& tasks = metadataResult->tasks) {
+			s_tasks.threads = tasks->threads.value_or(0);
+			s_tasks.affinity = tasks->affinity.value_or(std::vector<uint32_t>{});
+			s_tasks.budget = microseconds(tasks->budget_us.value_or(1000));
+		}
+
+		if (const auto& watchdog = metadataResult->watchdog) {
+			s_watchdog = {
+				.stall = milliseconds(watchdog->stall_ms.value_or(0)),
+				.abort = milliseconds(watchdog->abort_ms.value_or(0)),
+				.dump = watchdog->dump.value_or(true),
+			};
+		}
+
+		// Check if crashpad is enabled
+		if (!metadataResult->enabled.value_or(false)) {
+			return {};
+		}
+
+		s_timings.async = metadataResult->asynchronous_start.value_or(false);
+		if (s_timings.async) {
+			s_pending = std::async(
+			    std::launch::async,
+			    [exeDir, metadata = std::move(*metadataResult)] {
+				    StartupTrace::NameThread(StartupTrace::ThreadId(), "crashpad-start");
+				    return Start(exeDir, metadata, s_timings);
+			    }
+			);
+		} else {
+			std::promise<Result<std::unique_ptr<CrashpadClient>>> promise;
+			promise.set_value(Start(exeDir, *metadataResult, s_timings));
+			s_pending = promise.get_future();
+		}
+
+		return {};
+	}
+
+	// Readiness barrier, returns nullptr when crashpad is disabled
+	static Result<std::unique_ptr<CrashpadClient>> Wait() {
+		using namespace std::chrono;
+
+		if (!s_pending.valid()) {
+			return nullptr;
+		}
+
+		auto begin = steady_clock::now();
+		auto result = s_pending.get();
+		s_timings.wait = duration_cast<microseconds>(steady_clock::now() - begin);
+		return result;
+	}
+
+	static Timings& GetTimings() {
+		return s_timings;
+	}
+
+	static const Watchdog::Options& GetWatchdogOptions() {
+		return s_watchdog;
+	}
+
+	static const TaskPool::Options& GetTaskOptions() {
+		return s_tasks;
+	}
 };
 
 class PlugifyInitializer {
@@ -2723,6 +6722,7 @@ private:
 	}
 
 	static Result<void> InstallServerHooks() {
+		TraceScope scope("InstallServerHooks");
 		DynLibUtils::CModule server("server");
 		if (!server) {
 			return MakeError("Failed to load server module");
@@ -2737,6 +6737,7 @@ private:
 
 		DynLibUtils::CVirtualTable vtable(table);
 		s_ServerGamePostSimulate.Hook(vtable, &ServerGamePostSimulate);
+		ConsolePager::Attach();
 
 		plg::print("{}: Server hooks installed", Colorize("Info", Colors::GREEN));
 		return {};
@@ -2776,6 +6777,7 @@ private:
 #endif
 
 	static Result<fs::path> ValidateMicromamba(const fs::path& exePath) {
+		TraceScope scope("ValidateMicromamba");
 		std::error_code ec;
 		if (!fs::exists(exePath, ec)) {
 			return MakeError("Micromamba executable not found at: {}", exePath.string());
@@ -2793,50 +6795,140 @@ private:
 		return exePath;
 	}
 
-	static Config::Paths BuildPaths(const fs::path& baseDir) {
-		return {
-			.baseDir = baseDir,
-			.extensionsDir = "envs",
-			.configsDir = "configs",
-			.dataDir = "data",
-			.logsDir = "logs",
-			.cacheDir = "pkgs",
-		};
+	static Result<std::shared_ptr<Plugify>>
+	CreatePlugifyContext(const fs::path& baseDir, std::shared_ptr<ILogger> logger) {
+		TraceScope scope("CreatePlugifyContext");
+		return ::CreatePlugifyContext(baseDir, std::move(logger));
 	}
 
-	static Result<std::shared_ptr<Plugify>> CreatePlugifyContext(const fs::path& baseDir) {
-		// Build paths
-		auto paths = BuildPaths(baseDir);
+	// Read every manifest once so the manager's discovery pass hits a warm page cache
+	static size_t PrefetchManifests(const fs::path& extensionsDir) {
+		TraceScope scope("PrefetchManifests");
+		size_t count = 0;
+		std::error_code ec;
+		for (const auto& entry : fs::recursive_directory_iterator(
+		         extensionsDir,
+		         fs::directory_options::skip_permission_denied,
+		         ec
+		     )) {
+			if (!entry.is_regular_file(ec)) {
+				continue;
+			}
+			const auto& fileExt = plg::as_string(entry.path().extension());
+			if (fileExt != ".pplugin" && fileExt != ".pmodule" && fileExt != ".plg" && fileExt != ".mod") {
+				continue;
+			}
+			std::ifstream file(entry.path(), std::ios::binary);
+			char buffer[4096];
+			while (file.read(buffer, sizeof(buffer))) {
+			}
+			++count;
+		}
+		return count;
+	}
 
-		// Create context
-		auto buildResult = Plugify::CreateBuilder()
-			.WithLogger(s_logger)
-			.WithPaths(std::move(paths))
-			.Build();
+	// The manager only keeps per-operation durations, so each extension gets its own track
+	// with its phases laid end to end from the start of manager.Initialize()
+	static void TraceExtensions(const Manager& manager, std::chrono::microseconds origin) {
+		constexpr ExtensionState operations[] = {
+			ExtensionState::Parsing,
+			ExtensionState::Resolving,
+			ExtensionState::Loading,
+			ExtensionState::Starting,
+		};
+		constexpr uint32_t kExtensionTrackBase = 1000;
 
-		if (!buildResult) {
-			return MakeError("Failed to create Plugify context: {}", buildResult.error());
+		uint32_t track = kExtensionTrackBase;
+		for (const auto& ext : manager.GetExtensions()) {
+			StartupTrace::NameThread(
+			    track,
+			    std::format("{} {}", ext->IsPlugin() ? "plugin" : "module", ext->GetName())
+			);
+			auto cursor = origin;
+			for (const auto& op : operations) {
+				auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+				    ext->GetOperationTime(op)
+				);
+				if (duration.count() > 0) {
+					StartupTrace::Complete(std::string(plg::enum_to_string(op)), track, cursor, duration);
+					cursor += duration;
+				}
+			}
+			++track;
 		}
+	}
 
-		// Initialize context
-		auto context = std::move(*buildResult);
-		if (auto result = context->Initialize(); !result) {
-			return MakeError("Failed to initialize context: {}", result.error());
-		}
+	struct PreparedContext {
+		fs::path baseDir;
+		std::shared_ptr<Plugify> context;
+		size_t manifests{};
+		std::chrono::microseconds elapsed{};
+	};
 
-		// Initialize manager
-		auto& manager = context->GetManager();
-		if (auto result = manager.Initialize(); !result) {
-			return MakeError("Failed to initialize plugin manager: {}", result.error());
+	// Everything here must stay independent of engine interfaces
+	static Result<PreparedContext> PrepareContext(const fs::path& gameDir, std::shared_ptr<ILogger> logger) {
+		TraceScope scope("PrepareContext");
+		auto start = std::chrono::steady_clock::now();
+
+		fs::path baseDir = gameDir / BASE_PATH;
+		fs::path exePath = gameDir / MAMBA_PATH;
+
+		// Validate micromamba
+		if (auto mambaResult = ValidateMicromamba(exePath); !mambaResult) {
+			return MakeError(std::move(mambaResult.error()));
 		}
 
-		plg::print("{}: Plugify initialized successfully", Colorize("Success", Colors::GREEN));
+		auto paths = BuildPaths(baseDir);
+		auto manifests = PrefetchManifests(paths.baseDir / paths.extensionsDir);
 
-		return context;
+		// Create and initialize Plugify context
+		auto contextResult = CreatePlugifyContext(baseDir, std::move(logger));
+		if (!contextResult) {
+			return MakeError(std::move(contextResult.error()));
+		}
+
+		return PreparedContext{
+			.baseDir = baseDir,
+			.context = std::move(*contextResult),
+			.manifests = manifests,
+			.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+			    std::chrono::steady_clock::now() - start
+			),
+		};
 	}
 
+	inline static std::future<Result<PreparedContext>> s_prepared;
+	inline static std::shared_ptr<DeferredLogger> s_deferred;
+
 public:
+	// Start engine-independent initialization on a background thread while the engine boots.
+	// Its output is held by a DeferredLogger until Initialize() has set up logging.
+	static void Prepare(const fs::path& gameDir) {
+		s_deferred = std::make_shared<DeferredLogger>(s_logger);
+		s_prepared = std::async(std::launch::async, [gameDir, logger = s_deferred] {
+			StartupTrace::NameThread(StartupTrace::ThreadId(), "plugify-prepare");
+			std::string printed;
+			auto result = [&] {
+				OutputCapture capture(printed);
+				return PrepareContext(gameDir, logger);
+			}();
+			logger->Hold(std::move(printed));
+			return result;
+		});
+	}
+
+	// Wait for and drop a speculative context that was never joined, along with its held output
+	static void Discard() {
+		if (s_prepared.valid()) {
+			s_prepared.wait();
+			s_prepared = {};
+		}
+		s_deferred.reset();
+	}
+
 	static Result<std::shared_ptr<Plugify>> Initialize(CAppSystemDict* systems) {
+		TraceScope scope("PlugifyInitializer::Initialize");
+
 		// Setup logging if listener exists
 		if (s_listener) {
 			LoggingSystem_PushLoggingState(false, false);
@@ -2850,6 +6942,31 @@ public:
 		    Colorize(s_crashpad ? "enabled" : "disabled", Colors::MAGENTA)
 		);
 
+		if (s_crashpad) {
+			const auto& timings = CrashpadInitializer::GetTimings();
+			auto hidden = timings.total > timings.wait ? timings.total - timings.wait
+			                                          : std::chrono::microseconds{};
+			plg::print(
+			    "{}: Crashpad startup {} ({}) - metadata {}, handler {}, directories {}, database {}, logging {}, spawn {}",
+			    Colorize("Info", Colors::BLUE),
+			    FormatDuration(timings.total),
+			    timings.async ? "async" : "sync",
+			    FormatDuration(timings.metadata),
+			    FormatDuration(timings.handler),
+			    FormatDuration(timings.directories),
+			    FormatDuration(timings.database),
+			    FormatDuration(timings.logging),
+			    FormatDuration(timings.start)
+			);
+			plg::print(
+			    "{}: Engine load {}, blocked on crash handler {}, overlapped {}",
+			    Colorize("Info", Colors::BLUE),
+			    FormatDuration(timings.engineLoad),
+			    FormatDuration(timings.wait),
+			    Colorize(FormatDuration(timings.async ? hidden : std::chrono::microseconds{}), Colors::GREEN)
+			);
+		}
+
 		// Find CVar interface
 		if (auto cvarResult = FindCVarInterface(systems); !cvarResult) {
 			plg::print("{}: {}", Colorize("Warning", Colors::YELLOW), cvarResult.error());
@@ -2877,31 +6994,101 @@ public:
 		// Register ConVars
 		ConVar_Register(FCVAR_RELEASE | FCVAR_SERVER_CAN_EXECUTE | FCVAR_GAMEDLL);
 
+		// Arm the stall watchdog, it stays idle until the first tick
+		Watchdog::Configure(CrashpadInitializer::GetWatchdogOptions());
+
 		// Build base directory path
 		fs::path gameDir(Plat_GetGameDirectory());
-		fs::path baseDir = gameDir / BASE_PATH;
-		fs::path exePath = gameDir / MAMBA_PATH;
 
-		// Validate micromamba
-		if (auto mambaResult = ValidateMicromamba(exePath); !mambaResult) {
-			return MakeError(std::move(mambaResult.error()));
+		// Join the speculative context, or build it now if none was started. Its held output is
+		// replayed first so it lands in the log file in order.
+		auto prepared = s_prepared.valid() ? s_prepared.get() : PrepareContext(gameDir, s_logger);
+		if (s_deferred) {
+			s_deferred->Replay();
 		}
 
-		// Create and initialize Plugify context
-		return CreatePlugifyContext(baseDir);
+		// The speculative base directory was derived from the binary location, only adopt it
+		// when it is the one the engine reports
+		if (prepared) {
+			fs::path baseDir = gameDir / BASE_PATH;
+			std::error_code ec;
+			if (!fs::equivalent(prepared->baseDir, baseDir, ec)) {
+				plg::print(
+				    "{}: Speculative context used '{}' but base directory is '{}', rebuilding",
+				    Colorize("Warning", Colors::YELLOW),
+				    plg::as_string(prepared->baseDir),
+				    plg::as_string(baseDir)
+				);
+				prepared = PrepareContext(gameDir, s_logger);
+			}
+		}
+		if (!prepared) {
+			return MakeError(std::move(prepared.error()));
+		}
+
+		auto context = std::move(prepared->context);
+
+		// Initialize manager
+		auto start = std::chrono::steady_clock::now();
+		auto traceStart = StartupTrace::Now();
+		auto& manager = context->GetManager();
+		{
+			TraceScope managerScope("manager.Initialize");
+			if (auto result = manager.Initialize(); !result) {
+				return MakeError("Failed to initialize plugin manager: {}", result.error());
+			}
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+		    std::chrono::steady_clock::now() - start
+		);
+
+		if (StartupTrace::IsEnabled()) {
+			TraceExtensions(manager, traceStart);
+		}
+		RecordExtensions(manager);
+
+		plg::print(
+		    "{}: Plugify initialized successfully {}",
+		    Colorize("Success", Colors::GREEN),
+		    Colorize(
+		        std::format(
+		            "[context {} ({} manifests), manager {}]",
+		            FormatDuration(prepared->elapsed),
+		            prepared->manifests,
+		            FormatDuration(elapsed)
+		        ),
+		        Colors::GRAY
+		    )
+		);
+
+		return context;
 	}
 };
 
 DynLibUtils::CVTFHookAuto<&CAppSystemDict::OnAppSystemLoaded> s_OnAppSystemLoaded;
 std::unordered_set<std::string> s_loadList;
 
-void OnAppSystemLoaded(CAppSystemDict* pThis) {
-	s_OnAppSystemLoaded.Call(pThis);
-
-	if (s_plugify) {
+void WriteStartupTrace() {
+	if (!StartupTrace::IsEnabled()) {
 		return;
 	}
 
+	fs::path gameDir(Plat_GetGameDirectory());
+	auto path = gameDir / BASE_PATH / "logs" / FormatFileName("startup-trace", "json");
+	if (auto result = StartupTrace::Write(path)) {
+		plg::print(
+		    "{}: Startup trace with {} events written to {}",
+		    Colorize("Info", Colors::BLUE),
+		    *result,
+		    plg::as_string(path)
+		);
+	} else {
+		plg::print("{}: {}", Colorize("Warning", Colors::YELLOW), result.error());
+	}
+}
+
+// Returns true once initialization was attempted
+bool TryInitializePlugify(CAppSystemDict* pThis) {
 	if (s_loadList.empty()) {
 		s_loadList.reserve(static_cast<size_t>(pThis->m_Modules.Count()));
 	}
@@ -2919,15 +7106,36 @@ void OnAppSystemLoaded(CAppSystemDict* pThis) {
 
 						// Optionally: decide if this should be fatal
 						// throw std::runtime_error(result.error());
-						return;
+						return true;
 					}
 
 					s_plugify = std::move(*result);
-					break;
+					Watchdog::RefreshModules();
+					return true;
 				}
 			}
 		}
 	}
+
+	return false;
+}
+
+void OnAppSystemLoaded(CAppSystemDict* pThis) {
+	if (s_plugify) {
+		s_OnAppSystemLoaded.Call(pThis);
+		return;
+	}
+
+	bool attempted;
+	{
+		TraceScope scope("OnAppSystemLoaded");
+		s_OnAppSystemLoaded.Call(pThis);
+		attempted = TryInitializePlugify(pThis);
+	}
+
+	if (attempted) {
+		WriteStartupTrace();
+	}
 }
 
 std::optional<fs::path> ExecutablePath() {
@@ -2956,6 +7164,36 @@ std::optional<fs::path> ExecutablePath() {
 }
 
 int main(int argc, char* argv[]) {
+	std::vector<std::string_view> arguments(argv + 1, argv + argc);
+	if (auto it = std::ranges::find(arguments, "--plugify-trace-startup"); it != arguments.end()) {
+		arguments.erase(it);
+		StartupTrace::Enable();
+		StartupTrace::NameThread(StartupTrace::ThreadId(), "main");
+	}
+
+	// Headless replay harness, the file is taken as given
+	if (auto it = std::ranges::find(arguments, "--plugify-replay"); it != arguments.end() && it + 1 != arguments.end()) {
+		fs::path path(*(it + 1));
+		arguments.erase(it, it + 2);
+
+		auto value = [&](std::string_view name, auto fallback) {
+			auto option = std::ranges::find(arguments, name);
+			if (option == arguments.end() || option + 1 == arguments.end()) {
+				return fallback;
+			}
+			auto parsed = fallback;
+			std::string_view text = *(option + 1);
+			std::from_chars(text.data(), text.data() + text.size(), parsed);
+			arguments.erase(option, option + 2);
+			return parsed;
+		};
+		auto speed = value("--plugify-replay-speed", 0.0);
+		auto repeat = value("--plugify-replay-repeat", 1);
+		CommandReplay::Queue(std::move(path), std::max(speed, 0.0), std::max(repeat, 1));
+	}
+
+	TraceScope mainScope("main");
+
 	auto binary_path = ExecutablePath().value_or(fs::current_path());
 
 	std::error_code ec;
@@ -2964,15 +7202,16 @@ int main(int argc, char* argv[]) {
 	}
 
 	if (!std::is_debugger_present()) {
-		auto result = CrashpadInitializer::Initialize(binary_path, "crashpad.jsonc");
+		TraceScope scope("Crashpad::Launch");
+		auto result = CrashpadInitializer::Launch(binary_path, "crashpad.jsonc");
 		if (!result) {
 			std::println(std::cerr, "Crashpad error: {}", result.error());
 			return 1;
 		}
-
-		s_crashpad = true;
 	}
 
+	TaskPool::Start(CrashpadInitializer::GetTaskOptions());
+
 	auto engine_path = binary_path / S2_LIBRARY_PREFIX "engine2" S2_LIBRARY_SUFFIX;
 	auto parent_path = binary_path.generic_string();
 
@@ -2982,16 +7221,29 @@ int main(int argc, char* argv[]) {
 	int flags = RTLD_NOW | RTLD_GLOBAL;
 #endif
 
+	auto engine_start = std::chrono::steady_clock::now();
+
 	DynLibUtils::CModule engine{};
-	engine.LoadFromPath(plg::as_string(engine_path), flags);
+	{
+		TraceScope scope("engine.LoadFromPath");
+		engine.LoadFromPath(plg::as_string(engine_path), flags);
+	}
 	if (!engine) {
 		std::println(std::cerr, "Launcher error: {} - {}", engine.GetLastError(), plg::as_string(engine_path));
+		std::ignore = CrashpadInitializer::Wait();
 		return 1;
 	}
 
+	CrashpadInitializer::GetTimings().engineLoad = std::chrono::duration_cast<std::chrono::microseconds>(
+	    std::chrono::steady_clock::now() - engine_start
+	);
+
 	s_logger = std::make_shared<ConsoleLoggger>("plugify");
 	s_logger->SetLogLevel(Severity::Info);
 
+	// binary_path is <game>/bin/<platform>
+	PlugifyInitializer::Prepare(binary_path.parent_path().parent_path());
+
 	auto table = engine.GetVirtualTableByName("CMaterialSystem2AppSystemDict");
 	DynLibUtils::CVirtualTable vtable(table);
 	s_OnAppSystemLoaded.Hook(vtable, &OnAppSystemLoaded);
@@ -3006,13 +7258,37 @@ int main(int argc, char* argv[]) {
 	);
 	auto Source2Main = engine.GetFunctionByName("Source2Main").RCast<Source2MainFn>();
 
-	auto command_line = argc > 1 ? plg::join(std::span(argv + 1, argc - 1), " ") : "";
-	int res = Source2Main(nullptr, nullptr, command_line.c_str(), 0, parent_path.c_str(), S2_GAME_NAME);
+	// Engine code runs from here on, so the crash handler has to be ready
+	auto crashpad = [] {
+		TraceScope scope("Crashpad::Wait");
+		return CrashpadInitializer::Wait();
+	}();
+	if (!crashpad) {
+		std::println(std::cerr, "Crashpad error: {}", crashpad.error());
+		return 1;
+	}
+
+	s_crashpad = *crashpad != nullptr;
+
+	auto command_line = plg::join(arguments, " ");
+	int res;
+	{
+		TraceScope scope("Source2Main");
+		res = Source2Main(nullptr, nullptr, command_line.c_str(), 0, parent_path.c_str(), S2_GAME_NAME);
+	}
+
+	PlugifyInitializer::Discard();
 
 	if (s_listener) {
 		LoggingSystem_PopLoggingState();
 	}
 
+	Watchdog::Stop();
+	MambaJobs::Shutdown();
+	TaskPool::Stop();
+	FlightRecorder::Close();
+
+	ConsolePager::Detach();
 	s_ServerGamePostSimulate.Unhook();
 	s_OnAppSystemLoaded.Unhook();
 